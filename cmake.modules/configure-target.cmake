@@ -25,6 +25,10 @@ macro(__common_config arg_target)
         target_compile_definitions(${arg_target} PUBLIC MOX_ENABLE_LOGS)
     endif()
 
+    if (MOX_VARIANT_INLINE_SIZE)
+        target_compile_definitions(${arg_target} PUBLIC MOX_VARIANT_INLINE_SIZE=${MOX_VARIANT_INLINE_SIZE})
+    endif()
+
     if ("${CMAKE_BUILD_TYPE}" STREQUAL "Debug")
         target_compile_definitions(${arg_target} PUBLIC DEBUG)
     endif()
@@ -26,6 +26,7 @@
 #include <mox/core/meta/signal/signal.hpp>
 
 #include <chrono>
+#include <future>
 
 namespace mox
 {
@@ -40,6 +41,8 @@ enum class EventType : int32_t
     Base,
     Quit,
     DeferredSignal,
+    DeferredSignalBatch,
+    DeferredInvocation,
     UserType = 100
 };
 ENABLE_ENUM_OPERATORS(EventType)
@@ -131,11 +134,74 @@ class MOX_API DeferredSignalEvent : public Event
     Callable::ArgumentPack m_arguments;
 
 public:
-    explicit DeferredSignalEvent(ObjectSharedPtr target, Signal::Connection& connection, const Callable::ArgumentPack& args);
+    /// Constructs the event to activate the \a connection with the \a args on the thread of the
+    /// \a target. The arguments are moved into the event.
+    explicit DeferredSignalEvent(ObjectSharedPtr target, Signal::Connection& connection, Callable::ArgumentPack args);
 
     void activate();
 };
 
+class DeferredSignalMailbox;
+using DeferredSignalMailboxPtr = std::shared_ptr<DeferredSignalMailbox>;
+
+/// DeferredSignalBatchEvent delivers the deferred signal activations queued from one thread to the
+/// objects of an other thread. The activations are collected in a mailbox specific to the emitting
+/// and receiving thread pair, and a single batch event is posted to the receiving thread as long as
+/// the mailbox has undelivered activations. The activations are delivered in the order they were
+/// queued.
+class MOX_API DeferredSignalBatchEvent : public Event
+{
+    DISABLE_COPY(DeferredSignalBatchEvent)
+    DeferredSignalMailboxPtr m_mailbox;
+
+public:
+    /// Constructs the batch event for the \a mailbox, targeting the \a target thread object.
+    explicit DeferredSignalBatchEvent(ObjectSharedPtr target, DeferredSignalMailboxPtr mailbox);
+    /// Destructor. Releases the mailbox if the event was not dispatched.
+    ~DeferredSignalBatchEvent() override;
+
+    /// Batch events are never compressed, each mailbox schedules at most one batch at a time.
+    bool isCompressible() const override;
+
+    /// Activates the connections queued in the mailbox.
+    void activate();
+
+    /// Queues the activation of a \a connection with \a args to the thread of the \a receiver.
+    /// Posts a batch event to the receiver's thread only if the mailbox of the thread pair has no
+    /// batch scheduled.
+    /// \return If the activation is queued with success, returns \e true, otherwise \e false.
+    static bool post(ObjectSharedPtr receiver, Signal::Connection& connection, Callable::ArgumentPack args);
+};
+
+/// DeferredInvocationEvent invokes a callable on the thread of the target object, and completes
+/// the future of the invocation with the result of the callable. If the event is destroyed before
+/// it gets dispatched, the future reports a broken promise.
+class MOX_API DeferredInvocationEvent : public Event
+{
+    DISABLE_COPY(DeferredInvocationEvent)
+    Callable m_callable;
+    Callable::ArgumentPack m_arguments;
+    std::promise<Variant> m_result;
+
+public:
+    /// The future of the invocation result.
+    using Future = std::future<Variant>;
+
+    /// Constructs the event to invoke the \a callable with the \a arguments on the thread of the
+    /// \a target.
+    explicit DeferredInvocationEvent(ObjectSharedPtr target, Callable&& callable, Callable::ArgumentPack&& arguments);
+
+    /// Invocations are never compressed.
+    bool isCompressible() const override;
+
+    /// Returns the future of the invocation result. Call it only once.
+    Future getFuture();
+
+    /// Invokes the callable, and moves the result, or the exception thrown by the callable, into
+    /// the future.
+    void activate();
+};
+
 template <class EventClass, class TargetPtr, typename... Arguments>
 auto make_event(TargetPtr target, Arguments&&... arguments)
 {
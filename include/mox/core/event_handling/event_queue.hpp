@@ -23,6 +23,7 @@
 #include <mox/core/event_handling/event.hpp>
 #include <mox/core/meta/base/metabase.hpp>
 #include <mox/utils/log/logger.hpp>
+#include <mox/utils/containers/mpsc_queue.hpp>
 
 #include <functional>
 #include <queue>
@@ -49,12 +50,23 @@ public:
 
     /// Clears the event queue.
     void clear();
-    /// Returns the size of the event queue.
+    /// Returns the size of the event queue, including the posted events not yet moved into the
+    /// queue.
     size_t size() const;
     /// Returns \e true if the event queue is empty, \e false otherwise.
     bool empty() const;
     /// Pushes an \a event to the event queue. Updates the timestamp of the event pushed.
     void push(EventPtr event);
+    /// Posts an \a event to the event queue without locking the queue. You can call this method
+    /// from any thread. Updates the timestamp of the event posted. The posted events are moved into
+    /// the queue, in the order they were posted, when the queue is processed. The event compression
+    /// is applied at that time.
+    /// \return If the consumer of the queue must be woken up, returns \e true. Returns \e false
+    /// if a wakeup is already pending for the events posted earlier.
+    bool post(EventPtr event);
+    /// Cancels the pending wakeup of the queue consumer. Call this when the wakeup requested by
+    /// post() cannot be delivered, so that a subsequent post() requests a new one.
+    void cancelWakeUp();
     /// Processes the event queue, popping each event from the queue and passing those
     /// to the \a dispatcher function. The processing continues till there are events in
     /// the queue and till the dispatcher returns true. When the dispatcher returns false,
@@ -65,16 +77,32 @@ public:
     void process(DispatchFunction dispatcher)
     {
         lock_guard lock(*this);
-        while (!empty())
+        fetchPostedEvents();
+        while (!EventQueueBase::empty())
         {
             EventPtr ev(std::move(c.front()));
             pop();
 
-            ScopeRelock relock(*this);
-            CTRACE(event, "Processing event:" << int(ev->type()));
-            dispatcher(*ev);
+            {
+                ScopeRelock relock(*this);
+                CTRACE(event, "Processing event:" << int(ev->type()));
+                dispatcher(*ev);
+            }
+            fetchPostedEvents();
         }
     }
+
+private:
+    // Pushes an event to the queue. The queue must be locked.
+    void enqueue(EventPtr event);
+    // Moves the posted events into the queue. The queue must be locked.
+    void fetchPostedEvents();
+
+    // The posted events are consumed under the queue lock only, which makes the lock holder the
+    // single consumer of the inbox.
+    MpscQueue<EventPtr> m_postedEvents;
+    std::atomic_size_t m_postedCount = 0u;
+    std::atomic_bool m_wakeUpPending = false;
 };
 
 }
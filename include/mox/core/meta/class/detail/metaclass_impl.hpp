@@ -62,8 +62,13 @@ template <class HostClass, typename... Arguments>
 template <typename... ConvertibleArgs>
 int MetaClass::MetaSignal<HostClass, Arguments...>::emit(MetaBase& sender, ConvertibleArgs... arguments)
 {
-    auto argPack = Callable::ArgumentPack(arguments...);
-    return sender.activateSignal(*this, argPack);
+    auto signal = sender.findSignal(*this);
+    if (!signal)
+    {
+        return -1;
+    }
+    // The activation packs the arguments on the first connection that cannot take the native arguments.
+    return signal->activate(Signal::TypedArgumentPack<ConvertibleArgs...>(arguments...));
 }
 /******************************************************************************
  * MetaClass::MetaProperty
@@ -144,66 +149,22 @@ const typename StaticMetaClass<MetaClassDecl, BaseClass, SuperClasses...>::Decla
 template <class Class, typename... Arguments>
 int emit(Class& instance, std::string_view signalName, Arguments... arguments)
 {
-    const auto* metaClass = Class::StaticMetaClass::get();
-    VariantDescriptorContainer descriptors(arguments...);
-    // Metasignal lookup.
-    auto signalVisitor = [signalName, &descriptors](const auto* signal, const auto& meta) -> bool
-    {
-        return (meta.name() == signalName) && signal->getArguments().isInvocableWith(descriptors);
-    };
-    auto signal = metaClass->visitSignals(signalVisitor);
-    if (signal)
-    {
-        return instance.activateSignal(*signal, Callable::ArgumentPack(arguments...));
-    }
-
-    return -1;
+    return PreparedEmit<Class, Arguments...>(signalName)(instance, arguments...);
 }
 
 template <class Class, typename... Arguments>
 std::optional<Variant> invoke(Class& instance, std::string_view methodName, Arguments... arguments)
 {
-    const auto* metaClass = Class::StaticMetaClass::get();
-    VariantDescriptorContainer descriptors(arguments...);
-
-    // Metamethod lookup.
-    auto methodVisitor = [methodName, &descriptors](const auto method, const auto& meta) -> bool
-    {
-        return (meta.name() == methodName) && method->isInvocableWith(descriptors);
-    };
-    const auto metaMethod = metaClass->visitMethods(methodVisitor);
-    if (metaMethod)
-    {
-        try
-        {
-            auto argPack = (metaMethod->type() == FunctionType::Method)
-                    ? Callable::ArgumentPack(&instance, arguments...)
-                    : Callable::ArgumentPack(arguments...);
-
-            auto result = metaMethod->apply(argPack);
-            return std::make_optional(result);
-        }
-        catch (...)
-        {
-            return std::nullopt;
-        }
-    }
-
-    return std::nullopt;
+    return PreparedInvoke<Class, Arguments...>(methodName)(instance, arguments...);
 }
 
 template <typename ValueType, class Class>
 std::optional<ValueType> getProperty(Class& instance, std::string_view property)
 {
-    const auto* metaClass = Class::StaticMetaClass::get();
-    auto finder = [&property](const auto*, const auto& meta)
+    const auto& metaProperties = Class::StaticMetaClass::get()->findProperties(property);
+    if (!metaProperties.empty())
     {
-        return meta.name() == property;
-    };
-    auto metaProperty = metaClass->visitProperties(finder);
-    if (metaProperty)
-    {
-        ValueType value = instance.getProperty(*metaProperty);
+        ValueType value = instance.getProperty(*metaProperties.front());
         return std::make_optional(value);
     }
     return std::nullopt;
@@ -212,50 +173,113 @@ std::optional<ValueType> getProperty(Class& instance, std::string_view property)
 template <typename ValueType, class Class>
 bool setProperty(Class& instance, std::string_view property, ValueType value)
 {
-    const auto* metaClass = Class::StaticMetaClass::get();
-    auto finder = [&property](const auto*, const auto& meta)
-    {
-        return meta.name() == property;
-    };
-    auto metaProperty = metaClass->visitProperties(finder);
-    if (metaProperty)
+    const auto& metaProperties = Class::StaticMetaClass::get()->findProperties(property);
+    if (!metaProperties.empty())
     {
-        return instance.setProperty(*metaProperty, Variant(value)) != nullptr;
+        return instance.setProperty(*metaProperties.front(), Variant(value)) != nullptr;
     }
     return false;
 }
 
 template <class Sender, class Receiver>
-Signal::ConnectionSharedPtr connect(Sender& sender, std::string_view signal, Receiver& receiver, std::string_view slot)
+Signal::ConnectionSharedPtr connect(Sender& sender, std::string_view signal, Receiver& receiver, std::string_view slot, Signal::ConnectionType type)
 {
-    const auto* mcSender = Sender::StaticMetaClass::get();
-    auto sigFinder = [signal](const auto, const auto& meta)
-    {
-        return meta.name() == signal;
-    };
-    auto metaSignal = mcSender->visitSignals(sigFinder);
-    if (!metaSignal)
+    const auto& metaSignals = Sender::StaticMetaClass::get()->findSignals(signal);
+    if (metaSignals.empty())
     {
         return nullptr;
     }
-    auto sig = sender.findSignal(*metaSignal);
+    auto sig = sender.findSignal(*metaSignals.front());
     if (!sig)
     {
         return nullptr;
     }
 
-    const auto* mcReceiver = Receiver::StaticMetaClass::get();
-    auto slotFinder = [slot, sig](const auto method, const auto& meta)
+    for (auto metaSlot : Receiver::StaticMetaClass::get()->findMethods(slot))
     {
-        return (meta.name() == slot) && method->isInvocableWith(sig->getType()->getArguments());
-    };
-    auto metaSlot = mcReceiver->visitMethods(slotFinder);
-    if (!metaSlot)
+        if (metaSlot->isInvocableWith(sig->getType()->getArguments()))
+        {
+            return connect(*sig, receiver, *metaSlot, type);
+        }
+    }
+
+    return nullptr;
+}
+
+/******************************************************************************
+ * prepared meta-invocators
+ */
+template <class Class, typename... Arguments>
+PreparedInvoke<Class, Arguments...>::PreparedInvoke(std::string_view methodName)
+{
+    const std::array<VariantDescriptor, sizeof...(Arguments)> descriptors = {{VariantDescriptor::get<Arguments>()...}};
+    for (auto method : Class::StaticMetaClass::get()->findMethods(methodName))
     {
-        return nullptr;
+        if (method->descriptors().isInvocableWith(descriptors.data(), descriptors.data() + descriptors.size()))
+        {
+            m_method = method;
+            break;
+        }
     }
+}
+
+template <class Class, typename... Arguments>
+std::optional<Variant> PreparedInvoke<Class, Arguments...>::operator()(Class& instance, Arguments... arguments) const
+{
+    if (!m_method)
+    {
+        return std::nullopt;
+    }
+    try
+    {
+        auto argPack = (m_method->type() == FunctionType::Method)
+                ? Callable::ArgumentPack(&instance, arguments...)
+                : Callable::ArgumentPack(arguments...);
+
+        auto result = m_method->apply(argPack);
+        return std::make_optional(result);
+    }
+    catch (...)
+    {
+        return std::nullopt;
+    }
+}
+
+template <class Class, typename... Arguments>
+PreparedEmit<Class, Arguments...>::PreparedEmit(std::string_view signalName)
+{
+    const std::array<VariantDescriptor, sizeof...(Arguments)> descriptors = {{VariantDescriptor::get<Arguments>()...}};
+    for (auto signalType : Class::StaticMetaClass::get()->findSignals(signalName))
+    {
+        if (signalType->getArguments().isInvocableWith(descriptors.data(), descriptors.data() + descriptors.size()))
+        {
+            m_signalType = signalType;
+            break;
+        }
+    }
+}
+
+template <class Class, typename... Arguments>
+int PreparedEmit<Class, Arguments...>::operator()(Class& instance, Arguments... arguments) const
+{
+    auto signal = m_signalType ? instance.findSignal(*m_signalType) : nullptr;
+    if (!signal)
+    {
+        return -1;
+    }
+    return signal->activate(Signal::TypedArgumentPack<Arguments...>(arguments...));
+}
+
+template <class Class, typename... Arguments>
+PreparedInvoke<Class, Arguments...> prepareInvoke(std::string_view methodName)
+{
+    return PreparedInvoke<Class, Arguments...>(methodName);
+}
 
-    return connect(*sig, receiver, *metaSlot);
+template <class Class, typename... Arguments>
+PreparedEmit<Class, Arguments...> prepareEmit(std::string_view signalName)
+{
+    return PreparedEmit<Class, Arguments...>(signalName);
 }
 
 } // metainfo
@@ -19,6 +19,9 @@
 #ifndef METACLASS_HPP
 #define METACLASS_HPP
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string_view>
 
@@ -58,6 +61,7 @@ std::pair<Metatype, Metatype> registerMetaClass(std::string_view name = "");
 
 class MetaObject;
 struct MetaClass;
+struct MetaData;
 class PropertyType;
 class MethodType;
 
@@ -72,7 +76,7 @@ public:
 
     /// Returns the name of the metainfo.
     /// \return The name of the metainfo.
-    std::string name() const;
+    const std::string& name() const;
 
     /// Returns the signature of the metainfo.
     virtual std::string signature() const = 0;
@@ -113,7 +117,7 @@ private:
             : Callable(method)
             , AbstractMetaInfo(name)
         {
-            hostClass.addMetaMethod(*this);
+            hostClass.addMember(*this);
         }
         std::string signature() const override;
     };
@@ -139,6 +143,12 @@ public:
     /// Metaclass visitor function.
     using MetaClassVisitor = std::function<VisitorResultType(const MetaClass&)>;
 
+    /// Lists of members sharing the same name, in the order the metaclass and its superclasses
+    /// are visited.
+    using MethodList = std::vector<const Callable*>;
+    using SignalList = std::vector<const SignalType*>;
+    using PropertyList = std::vector<const PropertyType*>;
+
     /// Metasignal class, declares a signal type with an associated name.
     template <class HostClass, typename... Arguments>
     class MOX_API MetaSignal : public MetaSignalBase
@@ -147,7 +157,9 @@ public:
         /// Constructor.
         MetaSignal(std::string_view name);
 
-        /// Emits the signal on a sender object passing the arguments.
+        /// Emits the signal on a sender object passing the arguments. The slots with the same
+        /// signature as the arguments are invoked with the native arguments. The arguments are
+        /// packed only for the slots that require conversion.
         template <typename... ConvertibleArgs>
         int emit(MetaBase& sender, ConvertibleArgs... arguments);
     };
@@ -184,17 +196,20 @@ public:
     /// Destructor.
     virtual ~MetaClass();
 
-    /// Adds a \a method to the metaclass.
+    /// Adds a \a method to the metaclass. The members of a metaclass are frozen once the
+    /// metaclass, or a class deriving from it, is looked up by member name. Adding a member to a
+    /// frozen metaclass is fatal.
     void addMetaMethod(Callable& method);
-    /// Adds a \s signal to the metaclass.
+    /// Adds a \s signal to the metaclass. Fatal if the members of the metaclass are frozen.
     void addMetaSignal(SignalType& signal);
-    /// Adds a \a property to the metaclass.
+    /// Adds a \a property to the metaclass. Fatal if the members of the metaclass are frozen.
     void addMetaProperty(PropertyType& property);
 
     /// Tests whether this MetaClass is the superclass of the \a metaClass passed as argument.
     bool isSuperClassOf(const MetaClass& metaClass) const;
 
-    /// Tests whether this MetaClass derives from the \a metaClass passed as argument.
+    /// Tests whether this MetaClass derives from the \a metaClass passed as argument. The test
+    /// uses the ancestor set of the metaclass, which is collected on the first test.
     bool derivesFrom(const MetaClass& metaClass) const;
 
     /// Returns the MetaClass that manages the \a className class.
@@ -218,6 +233,18 @@ public:
     /// no property is identified by the visitor.
     const PropertyType* visitProperties(const PropertyVisitor& visitor) const;
 
+    /// \name Name lookup
+    /// The lookups use a name index of the metaclass, which holds the members of the metaclass and
+    /// of its superclasses. The index is built on the first lookup.
+    /// \{
+    /// Returns the methods with the given \a name.
+    const MethodList& findMethods(std::string_view name) const;
+    /// Returns the signals with the given \a name.
+    const SignalList& findSignals(std::string_view name) const;
+    /// Returns the properties with the given \a name.
+    const PropertyList& findProperties(std::string_view name) const;
+    /// \}
+
     /// Returns the pair of metatypes representing the static and dynamic types of the MetaClass.
     const std::pair<Metatype, Metatype>& getMetaTypes() const
     {
@@ -235,13 +262,36 @@ protected:
     using MetaSignalContainer = std::vector<const MetaSignalBase*>;
     using MetaPropertyContainer = std::vector<const MetaPropertyBase*>;
 
-    /// Creates a metaclass with a registered MetatypeDescriptor identifier.
+    /// Creates a metaclass with a registered MetatypeDescriptor identifier. The metaclass name
+    /// is registered to the metadata on the first metaclass lookup by name.
     explicit MetaClass(std::pair<Metatype, Metatype> type);
 
     MetaMethodContainer m_metaMethods;
     MetaSignalContainer m_metaSignals;
     MetaPropertyContainer m_metaProperties;
     std::pair<Metatype, Metatype> m_type;
+
+private:
+    friend struct mox::MetaData;
+
+    void addMember(const MetaMethodBase& method);
+    void addMember(const MetaSignalBase& signal);
+    void addMember(const MetaPropertyBase& property);
+
+    struct NameIndex;
+    const NameIndex& getNameIndex() const;
+    const std::vector<uint64_t>& getAncestors() const;
+
+    mutable std::once_flag m_nameIndexBuilt;
+    mutable std::unique_ptr<NameIndex> m_nameIndex;
+    // Set when the metaclass gets in the name index of itself or of a class deriving from it.
+    mutable std::atomic_bool m_membersFrozen = false;
+    // The ancestors of the metaclass, as a bitset indexed by the class index of the metaclasses.
+    mutable std::once_flag m_ancestorsBuilt;
+    mutable std::vector<uint64_t> m_ancestors;
+    const size_t m_classIndex;
+    // The next metaclass waiting for name registration.
+    mutable const MetaClass* m_nextPending = nullptr;
 };
 
 
@@ -318,8 +368,9 @@ bool setProperty(Class& instance, std::string_view property, ValueType value);
 /// Creates a connection between a \a signal and a \a metaMethod of a \a receiver.
 /// \param receiver The receiver hosting the metamethod.
 /// \param metaMethod The metamethod to connect to.
+/// \param type The connection type. Applies only to receivers derived from Object.
 /// \return The connection shared object.
-MOX_API Signal::ConnectionSharedPtr connect(Signal& signal, MetaBase& receiver, const Callable& metaMethod);
+MOX_API Signal::ConnectionSharedPtr connect(Signal& signal, MetaBase& receiver, const Callable& metaMethod, Signal::ConnectionType type = Signal::ConnectionType::Auto);
 
 /// Connects a \a signal from \a sender to a \a slot in \a receiver.
 /// \tparam Sender The sender class type.
@@ -328,9 +379,89 @@ MOX_API Signal::ConnectionSharedPtr connect(Signal& signal, MetaBase& receiver,
 /// \param signal The signal name in sender.
 /// \param receiver The receiver object.
 /// \param slot The name of the slot, the metamethod to connect.
+/// \param type The connection type. Applies only to receivers derived from Object.
 /// \return If the connection succeeds, returns the connection object. If the connection fails, returns \e nullptr.
 template <class Sender, class Receiver>
-Signal::ConnectionSharedPtr connect(Sender& sender, std::string_view signal, Receiver& receiver, std::string_view slot);
+Signal::ConnectionSharedPtr connect(Sender& sender, std::string_view signal, Receiver& receiver, std::string_view slot, Signal::ConnectionType type = Signal::ConnectionType::Auto);
+/// \}
+
+/// \name Prepared meta-invocators
+/// \{
+/// A metamethod call prepared for repeated invocation. The metamethod is looked up by name, and
+/// the overload that is invocable with the \a Arguments is selected once, when the call is prepared.
+/// Invoking the prepared call only packs the arguments and applies them on the metamethod.
+/// \tparam Class The class type of the instances to invoke the metamethod on.
+/// \tparam Arguments The types of the arguments passed on invocation.
+template <class Class, typename... Arguments>
+class PreparedInvoke
+{
+public:
+    /// Prepares the invocation of the metamethod identified by \a methodName.
+    explicit PreparedInvoke(std::string_view methodName);
+
+    /// Returns \e true if the prepared call has a metamethod to invoke.
+    bool isValid() const
+    {
+        return m_method != nullptr;
+    }
+
+    /// Returns the metamethod of the prepared call, \e nullptr if the call is not valid.
+    const Callable* method() const
+    {
+        return m_method;
+    }
+
+    /// Invokes the metamethod on an \a instance, passing the given \a arguments.
+    /// \returns If the prepared call is valid, and the metamethod is applied with success, returns
+    /// the return value of the metamethod, otherwise \e std::nullopt.
+    std::optional<Variant> operator()(Class& instance, Arguments... arguments) const;
+
+private:
+    const Callable* m_method = nullptr;
+};
+
+/// A metasignal emission prepared for repeated emits. The metasignal is looked up by name, and
+/// the signal that is invocable with the \a Arguments is selected once, when the emission is prepared.
+/// The prepared emission passes the native arguments to the signal.
+/// \tparam Class The class type of the instances to emit the metasignal on.
+/// \tparam Arguments The types of the arguments passed on emit.
+template <class Class, typename... Arguments>
+class PreparedEmit
+{
+public:
+    /// Prepares the emission of the metasignal identified by \a signalName.
+    explicit PreparedEmit(std::string_view signalName);
+
+    /// Returns \e true if the prepared emission has a metasignal to emit.
+    bool isValid() const
+    {
+        return m_signalType != nullptr;
+    }
+
+    /// Returns the metasignal of the prepared emission, \e nullptr if the emission is not valid.
+    const SignalType* signalType() const
+    {
+        return m_signalType;
+    }
+
+    /// Emits the metasignal on an \a instance, passing the given \a arguments.
+    /// \returns Returns emit count, or -1 if the emission is not valid, or the signal is not defined
+    /// on the instance.
+    int operator()(Class& instance, Arguments... arguments) const;
+
+private:
+    const SignalType* m_signalType = nullptr;
+};
+
+/// Prepares the invocation of the metamethod identified by \a methodName on the instances of \a Class,
+/// with the arguments of the types \a Arguments.
+template <class Class, typename... Arguments>
+PreparedInvoke<Class, Arguments...> prepareInvoke(std::string_view methodName);
+
+/// Prepares the emission of the metasignal identified by \a signalName on the instances of \a Class,
+/// with the arguments of the types \a Arguments.
+template <class Class, typename... Arguments>
+PreparedEmit<Class, Arguments...> prepareEmit(std::string_view signalName);
 /// \}
 
 } // metainfo
@@ -22,6 +22,8 @@
 #include <mox/utils/type_traits.hpp>
 #include <mox/utils/function_traits.hpp>
 
+#include <iterator>
+
 namespace mox
 {
 
@@ -66,9 +68,9 @@ Callable::ArgumentPack::ArgumentPack(Class&& instance, const ArgumentPack& other
 template <typename... Args>
 Callable::ArgumentPack::ArgumentPack(Args... arguments)
 {
-    std::array<Variant, sizeof... (Args)> aa = {{Variant(arguments)...}};
+    std::array<Variant, sizeof... (Args)> aa = {{Variant(std::move(arguments))...}};
     reserve(aa.size());
-    insert(end(), aa.begin(), aa.end());
+    insert(end(), std::make_move_iterator(aa.begin()), std::make_move_iterator(aa.end()));
 }
 
 template <typename Type>
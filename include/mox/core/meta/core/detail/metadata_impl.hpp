@@ -31,14 +31,25 @@ template <typename Type>
 Metatype metaType()
 {
     static_assert (!is_cstring<Type>::value, "Use std::string_view in reflections instead of cstrings");
-    Metatype type = metadata::findMetatype(getNakedTypeInfo<Type>());
-    throwIf<ExceptionType::MetatypeNotRegistered>(type == Metatype::Invalid);
+    auto& cache = metadata::MetatypeCache<remove_cvref_t<Type>>::type;
+    Metatype type = cache.load(std::memory_order_acquire);
+    if (type == Metatype::Invalid)
+    {
+        type = metadata::findMetatype(getNakedTypeInfo<Type>());
+        throwIf<ExceptionType::MetatypeNotRegistered>(type == Metatype::Invalid);
+        cache.store(type, std::memory_order_release);
+    }
     return type;
 }
 
 template <typename Type>
 const MetatypeDescriptor& metatypeDescriptor()
 {
+    const Metatype type = metadata::MetatypeCache<remove_cvref_t<Type>>::type.load(std::memory_order_acquire);
+    if (type != Metatype::Invalid)
+    {
+        return MetatypeDescriptor::get(type);
+    }
     const MetatypeDescriptor* descriptor = metadata::findMetatypeDescriptor(getNakedTypeInfo<Type>());
     FATAL(descriptor, std::string("metaTypeDescriptor<>(): unregistered type ") + getNakedTypeInfo<Type>().name());
     return *descriptor;
@@ -47,14 +58,23 @@ const MetatypeDescriptor& metatypeDescriptor()
 template <typename Type>
 Metatype registerMetaType(std::string_view name)
 {
+    auto& cache = metadata::MetatypeCache<remove_cvref_t<Type>>::type;
+    auto newType = cache.load(std::memory_order_acquire);
+    if (newType != Metatype::Invalid)
+    {
+        return newType;
+    }
+
     const auto& rtti = getNakedTypeInfo<Type>();
-    auto newType = metadata::findMetatype(rtti);
+    newType = metadata::findMetatype(rtti);
     if (newType != Metatype::Invalid)
     {
+        cache.store(newType, std::memory_order_release);
         return newType;
     }
 
     newType = metadata::tryRegisterMetatype(rtti, std::is_enum_v<Type>, std::is_class_v<Type>, std::is_pointer_v<Type>, name);
+    cache.store(newType, std::memory_order_release);
     if constexpr (std::is_pointer_v<Type>)
     {
         mox::registerConverter<Type, intptr_t>();
@@ -24,83 +24,137 @@ namespace mox
 {
 
 template <typename T>
-Variant::Variant(const T value)
-    : m_data(std::make_shared<Data>(value))
+struct Variant::ValueModel
 {
+    static constexpr bool isInline = std::is_trivially_copyable_v<T> &&
+                                     (sizeof(T) <= InlineStorageSize) &&
+                                     (alignof(T) <= alignof(Storage));
+    using StoredType = std::conditional_t<isInline, T, std::shared_ptr<const T>>;
+
+    template <typename Value>
+    static void construct(Storage& storage, Value&& value)
+    {
+        if constexpr (isInline)
+        {
+            new (&storage) T(std::forward<Value>(value));
+        }
+        else
+        {
+            new (&storage) StoredType(std::make_shared<const T>(std::forward<Value>(value)));
+        }
+    }
+
+    static const T& value(const Storage& storage)
+    {
+        if constexpr (isInline)
+        {
+            return *reinterpret_cast<const T*>(&storage);
+        }
+        else
+        {
+            return **reinterpret_cast<const StoredType*>(&storage);
+        }
+    }
+
+    static void copy(Storage& destination, const Storage& source)
+    {
+        new (&destination) StoredType(*reinterpret_cast<const StoredType*>(&source));
+    }
+
+    static void move(Storage& destination, Storage& source)
+    {
+        auto sourceValue = reinterpret_cast<StoredType*>(&source);
+        new (&destination) StoredType(std::move(*sourceValue));
+        sourceValue->~StoredType();
+    }
+
+    static void destroy(Storage& storage)
+    {
+        reinterpret_cast<StoredType*>(&storage)->~StoredType();
+    }
+
+    static const void* address(const Storage& storage)
+    {
+        // Converters receive the pointer types by value.
+        if constexpr (std::is_pointer_v<T>)
+        {
+            return reinterpret_cast<const void*>(value(storage));
+        }
+        else
+        {
+            return &value(storage);
+        }
+    }
+
+    static bool equals(const Storage& lhs, const Storage& rhs)
+    {
+        return value(lhs) == value(rhs);
+    }
+
+    static inline const VTable vtable = {&typeid(T), copy, move, destroy, address, equals};
+};
+
+template <typename T>
+Variant::Variant(T value)
+{
+    construct(std::move(value));
 }
 
 template <typename T>
 bool Variant::canConvert()
 {
-    return isValid() && MetatypeDescriptor::get(metaType()).findConverterTo(mox::metaType<T>()) != nullptr;
+    return isValid() && MetatypeDescriptor::findConverter(metaType(), mox::metaType<T>()) != nullptr;
 }
 
 template <typename T>
 Variant::operator T()
 {
-    FATAL(m_data, "Variant is not initialized.");
-    return m_data->get<T>();
+    return get<T>();
 }
 
 template <typename T>
 Variant::operator T() const
 {
-    FATAL(m_data, "Variant is not initialized.");
-    return m_data->get<T>();
+    return get<T>();
 }
 
 template <typename T>
-Variant& Variant::operator=(const T value)
+Variant& Variant::operator=(T value)
 {
     static_assert (!is_cstring<T>::value, "Variant cannot hold a cstring.");
     reset();
-    m_data = std::make_shared<Data>(value);
+    construct(std::move(value));
     return *this;
 }
 
-
 template <typename T>
-Variant::Data::Data(T value)
-    : m_value(value)
-    , m_typeDescriptor(value)
+void Variant::construct(T&& value)
 {
-    m_getter = [value]() -> void*
-    {
-        if constexpr (std::is_pointer_v<T>)
-        {
-            return reinterpret_cast<void*>(const_cast<T>(value));
-        }
-        else
-        {
-            return reinterpret_cast<void*>(const_cast<T*>(&value));
-        };
-    };
-
-    m_isEqual = [this](const Data& other)
-    {
-        T otherValue = std::any_cast<T>(other.m_value);
-        T thisValue = std::any_cast<T>(m_value);
-        return otherValue == thisValue;
-    };
+    using ValueType = std::decay_t<T>;
+    ValueModel<ValueType>::construct(m_storage, std::forward<T>(value));
+    m_vtable = &ValueModel<ValueType>::vtable;
+    m_typeDescriptor = VariantDescriptor::get<ValueType>();
 }
 
 template <typename T>
-T Variant::Data::get()
+T Variant::get() const
 {
-    T* value = std::any_cast<T>(&m_value);
-    if (value)
+    FATAL(m_vtable, "Variant is not initialized.");
+    using ValueType = std::remove_cv_t<T>;
+    using Model = ValueModel<ValueType>;
+
+    // The tables of the same type may differ between modules, fall back to the type info.
+    if ((m_vtable == &Model::vtable) || (*m_vtable->rtti == typeid(ValueType)))
     {
-        return *value;
+        return Model::value(m_storage);
     }
 
-    const auto& sourceType = MetatypeDescriptor::get(m_typeDescriptor.getType());
-    auto destinationType = mox::metaType<T>();
-    auto converter = sourceType.findConverterTo(destinationType);
+    auto destinationType = mox::metaType<ValueType>();
+    auto converter = MetatypeDescriptor::findConverter(m_typeDescriptor.getType(), destinationType);
     throwIf<ExceptionType::BadTypeConversion>(!converter);
 
-    void* sourceValue = m_getter();
-    auto tmp = converter->convert(sourceValue);
-    value = std::any_cast<T>(&tmp);
+    auto tmp = converter->convert(m_vtable->address(m_storage));
+    auto value = std::any_cast<ValueType>(&tmp);
     throwIf<ExceptionType::BadTypeConversion>(!value);
 
     return *value;
@@ -21,6 +21,7 @@
 
 #include <mox/config/platform_config.hpp>
 #include <mox/core/meta/core/metatype.hpp>
+#include <atomic>
 #include <functional>
 #include <typeindex>
 #include <typeinfo>
@@ -110,6 +111,14 @@ MOX_API Metatype findMetatype(const std::type_info& rtti);
 /// \return the MetatypeDescriptor associated to the \e rtti.
 MOX_API Metatype tryRegisterMetatype(const std::type_info &rtti, bool isEnum, bool isClass, bool isPointer, std::string_view name);
 
+/// Per-type cache of the metatype identifier, filled on the first successful lookup or registration
+/// of the \a Type. Metatypes are never unregistered, so the cached identifier stays valid.
+template <typename Type>
+struct MetatypeCache
+{
+    static inline std::atomic<Metatype> type = Metatype::Invalid;
+};
+
 }} // namespace mox::metadata
 
 #include <mox/core/meta/core/detail/metadata_impl.hpp>
@@ -55,6 +55,8 @@ enum class Metatype : int
     Int64Ptr,
     // Vectors
     Int32Vector,
+    // Shared buffers
+    Int32Buffer,
     // All user types to be installed here
     UserType
 };
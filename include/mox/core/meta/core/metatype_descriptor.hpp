@@ -21,6 +21,7 @@
 
 #include <string_view>
 #include <array>
+#include <atomic>
 #include <vector>
 #include <functional>
 #include <typeindex>
@@ -31,6 +32,11 @@
 
 namespace mox {
 
+namespace metainfo
+{
+struct MetaClass;
+}
+
 /// The MetatypeDescriptor class extends the RTTI of the types in Mox. Provides information
 /// about the type, such as constness, whether is a pointer or enum. It also stores
 /// a fully qualified name of the type. The MetatypeDescriptor is also used when comparing
@@ -208,6 +214,8 @@ private:
     using ConverterMap = std::unordered_map<Metatype, Converter>;
 
     ConverterMap m_converters;
+    // The metaclass of a class type, read without locking.
+    std::atomic<const metainfo::MetaClass*> m_metaClass = nullptr;
     char* m_name = nullptr;
     const std::type_info* m_rtti = nullptr;
     Metatype m_id = Metatype::Invalid;
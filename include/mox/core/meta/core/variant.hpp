@@ -20,27 +20,45 @@
 #define ANY_HPP
 
 #include <any>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <typeinfo>
 
 #include <mox/core/meta/core/variant_descriptor.hpp>
 
+#ifndef MOX_VARIANT_INLINE_SIZE
+/// The size of the Variant inline storage, in bytes. Trivially copyable values that fit into the
+/// inline storage are held by the variant without heap allocation.
+#define MOX_VARIANT_INLINE_SIZE 16
+#endif
+
 namespace mox
 {
 
 struct VariantDescriptor;
 /// The Variant class holds a value and its metatype passed as argument in metacalls.
+///
+/// Trivially copyable values up to MOX_VARIANT_INLINE_SIZE bytes are stored inline. Other values
+/// are stored on the heap, and are shared between the copies of the variant. The value operations
+/// are dispatched through a static table specific to the type of the value.
 struct MOX_API Variant
 {
     /// Constructor.
     explicit Variant() = default;
 
-    /// Templated constructor, initializes the argument with a given value.
+    /// Destructor.
+    ~Variant();
+
+    /// Templated constructor, initializes the argument with a given value. The value is moved
+    /// into the variant.
     template <typename T>
-    explicit Variant(const T value);
+    explicit Variant(T value);
 
     /// Copy constructor.
     Variant(const Variant& other);
     /// Move constructor.
-    Variant(Variant&& other);
+    Variant(Variant&& other) noexcept;
 
     /// Chacks if this variant is convertible into type T.
     /// \return \e true if this variant is convertible into type T, \e false otherwise.
@@ -61,11 +79,11 @@ struct MOX_API Variant
 
     /// Assignment operator.
     template <typename T>
-    Variant& operator=(const T value);
+    Variant& operator=(T value);
     /// Copy assignment operator.
     Variant& operator=(const Variant&);
     /// Move assignment operator.
-    Variant& operator=(Variant&&);
+    Variant& operator=(Variant&&) noexcept;
 
     /// Returns \e true if this variant holds a valid value.
     bool isValid() const;
@@ -80,27 +98,42 @@ struct MOX_API Variant
     const VariantDescriptor& descriptor() const;
 
     /// Swaps variants.
-    void swap(Variant& other);
+    void swap(Variant& other) noexcept;
 
 private:
-    struct Data
+    static constexpr std::size_t InlineStorageSize = MOX_VARIANT_INLINE_SIZE;
+
+    struct alignas(std::max_align_t) Storage
     {
-        typedef std::function<void*()> GetterFunction;
-        typedef std::function<bool(const Data&)> EqualFunction;
+        unsigned char bytes[InlineStorageSize];
+    };
 
-        MetaValue m_value;
-        mutable GetterFunction m_getter;
-        mutable EqualFunction m_isEqual;
-        VariantDescriptor m_typeDescriptor;
+    /// The value operations of a type.
+    struct VTable
+    {
+        const std::type_info* rtti;
+        void (*copy)(Storage& destination, const Storage& source);
+        void (*move)(Storage& destination, Storage& source);
+        void (*destroy)(Storage& storage);
+        const void* (*address)(const Storage& storage);
+        bool (*equals)(const Storage& lhs, const Storage& rhs);
+    };
 
-        template <typename T>
-        explicit Data(T value);
+    template <typename T>
+    struct ValueModel;
 
-        template <typename T>
-        T get();
-    };
+    template <typename T>
+    void construct(T&& value);
+
+    template <typename T>
+    T get() const;
+
+    Storage m_storage;
+    const VTable* m_vtable = nullptr;
+    VariantDescriptor m_typeDescriptor;
+
+    static_assert(InlineStorageSize >= sizeof(std::shared_ptr<void>), "The Variant inline storage must fit a shared pointer.");
 
-    std::shared_ptr<Data> m_data;
     friend bool operator==(const Variant &var1, const Variant &var2);
 };
 
@@ -157,7 +190,11 @@ bool MOX_API operator!=(const Variant &var1, const Variant &var2);
 namespace std
 {
 
-void swap(mox::Variant& lhs, mox::Variant& rhs);
+/// Swaps two variants.
+inline void swap(mox::Variant& lhs, mox::Variant& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
 
 }
 
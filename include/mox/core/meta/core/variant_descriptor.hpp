@@ -134,6 +134,10 @@ public:
     /// \return If the variant types from \a other are compatible, returns \e true, otherwise \e false.
     bool isInvocableWith(const VariantDescriptorContainer& other) const;
 
+    /// Tests whether the variant descriptors are compatible with the descriptors in the range
+    /// [\a begin, \a end). Use this when the actual parameters are not held in a container.
+    bool isInvocableWith(const VariantDescriptor* begin, const VariantDescriptor* end) const;
+
     template <typename... Arguments>
     bool isInvocableWithArgumentTypes() const
     {
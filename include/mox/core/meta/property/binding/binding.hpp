@@ -79,6 +79,9 @@ class BindingPrivate;
 /// is re-enabled, the binding restores the state of the target property to the state preserved by the
 /// binding, by re-evaluating the binding. You can control this behavior by disabling the feature on
 /// the binding. You can disable the feature by calling setEvaluateOnEnabled() method.
+///
+/// Bindings are evaluated when the properties they depend on change. Lazy bindings only mark their
+/// target property dirty, and are evaluated when the target property is read. See setLazy().
 class MOX_API Binding : public std::enable_shared_from_this<Binding>
 {
     DECLARE_PRIVATE(BindingPrivate)
@@ -134,6 +137,18 @@ public:
     /// \param doEvaluate If the feature is required, set \e true, otherwise set \e false.
     void setEvaluateOnEnabled(bool doEvaluate);
 
+    /// Returns the lazy state of the binding.
+    /// \return If the binding is lazy, returns \e true, otherwise returns \e false.
+    bool isLazy() const;
+
+    /// Changes the lazy state of the binding. A lazy binding is not evaluated when the properties
+    /// it depends on change, but marks its target property dirty. The binding is evaluated when the
+    /// dirty target is read, and the change signal of the target is emitted then, once for all the
+    /// changes since the last read. A lazy binding is evaluated on change when a binding that is
+    /// not lazy depends on its target.
+    /// \param lazy If the binding is lazy, set \e true, otherwise set \e false.
+    void setLazy(bool lazy);
+
     /// Returns the target property of the binding.
     /// \return If the binding is attached, returns the target property of the binding. If the property is
     /// detached, returns \e nullptr.
@@ -20,11 +20,14 @@
 #define PROPERTY_HPP
 
 #include <mox/config/platform_config.hpp>
+#include <mox/config/error.hpp>
 #include <mox/config/pimpl.hpp>
 #include <mox/core/meta/property/property_data.hpp>
 #include <mox/core/meta/property/property_type.hpp>
 #include <mox/core/meta/signal/signal.hpp>
 
+#include <typeinfo>
+
 namespace mox
 {
 
@@ -107,10 +110,164 @@ private:
     Property() = delete;
     DISABLE_COPY_OR_MOVE(Property)
 
+    template <typename ValueType>
+    friend class PropertyRef;
+
+    /// Returns the data provider of the property.
+    PropertyDataProvider& getDataProvider() const;
+    /// Informs the property being accessed. The caller must hold the host lock.
+    void notifyAccessed();
+    /// Prepares the property for a write. Removes the discardable bindings, and drops the pending
+    /// evaluation of the lazy binding.
+    void prepareWrite();
+    /// Tests whether the property has no bindings, and no bindings subscribed to its changes.
+    /// The caller must hold the host lock.
+    bool isUnbound() const;
+    /// Propagates a value change of the property the same way the setter does.
+    /// \param value The value to emit the change signal with. If invalid, the change signal is
+    /// emitted with the current value of the property.
+    void propagateChanges(const Variant& value);
+    /// Evaluates the lazy binding of the property, if the property is dirty.
+    void evaluateDirtyBinding();
+
     DECLARE_PRIVATE(PropertyStorage)
     pimpl::d_ptr_type<PropertyStorage> d_ptr;
 };
 
+/// PropertyUpdateScope batches the property updates made on the calling thread during its lifetime.
+/// The properties updated in the scope keep their new values, but notify their bindings and emit
+/// their change signals only when the outermost scope exits. On exit, the bindings subscribed to
+/// the updated properties are evaluated once each, with all the new values in place, and then the
+/// change signals of the updated properties are emitted, in the order of the first update.
+///
+/// The changes the bindings make on exit are propagated the same way as outside of an update scope.
+///
+/// Call commit() to close the scope when the errors of the propagation, like a binding loop, must
+/// reach the caller. The destructor never throws, it logs the errors of the propagation.
+class MOX_API PropertyUpdateScope
+{
+public:
+    /// Opens an update scope.
+    explicit PropertyUpdateScope();
+    /// Closes the update scope, unless the scope is committed. The outermost scope propagates the
+    /// changes.
+    ~PropertyUpdateScope();
+
+    /// Closes the update scope. The outermost scope propagates the changes, and rethrows the
+    /// exceptions raised by the propagation.
+    void commit();
+
+    /// Tests whether the calling thread has an active update scope.
+    static bool isActive();
+
+private:
+    DISABLE_COPY_OR_MOVE(PropertyUpdateScope)
+
+    bool m_closed = false;
+};
+
+/// PropertyRef provides typed access to a property. When the data provider of the property is a
+/// PropertyData<ValueType>, the accessors read, compare and write the value without converting
+/// it to a Variant, and the change signal is only activated if it has connections. Other data
+/// providers, including the ones deriving from PropertyData<ValueType>, which may override the
+/// data access, are accessed through the Variant getter and setter of the property.
+/// \tparam ValueType The value type of the property.
+template <typename ValueType>
+class PropertyRef
+{
+    Property& m_property;
+    PropertyData<ValueType>* m_data = nullptr;
+
+public:
+    /// Constructs the typed reference to a \a property.
+    explicit PropertyRef(Property& property)
+        : m_property(property)
+    {
+        if (!property.isValid())
+        {
+            return;
+        }
+        auto& provider = property.getDataProvider();
+        if (typeid(provider) == typeid(PropertyData<ValueType>))
+        {
+            m_data = static_cast<PropertyData<ValueType>*>(&provider);
+        }
+    }
+
+    /// Property getter.
+    /// \return The property value.
+    ValueType get() const
+    {
+        if (!m_data)
+        {
+            return static_cast<ValueType>(m_property.get());
+        }
+        m_property.evaluateDirtyBinding();
+        lock_guard lock(m_property);
+        m_property.notifyAccessed();
+        return *m_data;
+    }
+
+    /// Property setter. Removes the discardable bindings.
+    /// \param value The property value to set.
+    void set(const ValueType& value)
+    {
+        // In an update scope the value is written through the setter, which records the value
+        // the scope started with.
+        if (!m_data || PropertyUpdateScope::isActive())
+        {
+            m_property.set(Variant(value));
+            return;
+        }
+
+        throwIf<ExceptionType::InvalidProperty>(!m_property.isValid());
+        throwIf<ExceptionType::AttempWriteReadOnlyProperty>(m_property.isReadOnly());
+        bool unbound = false;
+        {
+            // Without bindings, the value is compared and written under a single lock.
+            lock_guard lock(m_property);
+            unbound = m_property.isUnbound();
+            if (unbound)
+            {
+                if (*m_data == value)
+                {
+                    return;
+                }
+                *m_data = value;
+            }
+        }
+
+        if (!unbound)
+        {
+            m_property.prepareWrite();
+            {
+                lock_guard lock(m_property);
+                if (*m_data == value)
+                {
+                    return;
+                }
+                *m_data = value;
+            }
+        }
+
+        // The value is converted only if the change signal has connections.
+        m_property.propagateChanges(m_property.changed.hasConnections() ? Variant(value) : Variant());
+    }
+
+    /// Cast operator, the property getter.
+    operator ValueType() const
+    {
+        return get();
+    }
+
+    /// Property setter.
+    /// \param value The value to set.
+    void operator=(const ValueType& value)
+    {
+        set(value);
+    }
+};
+
 class DynamicProperty;
 using DynamicPropertyPtr = std::shared_ptr<DynamicProperty>;
 using DynamicPropertyWeak = std::weak_ptr<DynamicProperty>;
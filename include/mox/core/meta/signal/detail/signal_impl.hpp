@@ -20,14 +20,199 @@
 #define SIGNAL_IMPL_HPP
 
 #include <mox/config/memory.hpp>
+#include <utility>
 
 namespace mox
 {
 
+namespace signal_detail
+{
+
+template <typename Function, std::size_t... Index>
+auto typedSignature(std::index_sequence<Index...>)
+    -> std::tuple<std::decay_t<typename function_traits<Function>::template argument<Index>::type>...>;
+
+/// The tuple of the decayed argument types of a \a Function.
+template <typename Function>
+using TypedSignature = decltype(typedSignature<Function>(std::make_index_sequence<function_traits<Function>::arity>()));
+
+template <typename Function, typename Signature>
+class FunctionTypedSlot;
+
+/// Typed slot of a function, functor or lambda. The slot shares the function with the callable of
+/// the connection, so both activation paths invoke the same functor instance.
+template <typename Function, typename... Arguments>
+class FunctionTypedSlot<Function, std::tuple<Arguments...>> : public Signal::TypedSlot
+{
+    std::shared_ptr<Function> m_function;
+
+public:
+    explicit FunctionTypedSlot(std::shared_ptr<Function> function)
+        : Signal::TypedSlot(typeid(std::tuple<Arguments...>))
+        , m_function(std::move(function))
+    {
+    }
+
+    void invoke(const Signal::TypedArguments& arguments) override
+    {
+        std::apply(*m_function, static_cast<const Signal::TypedArgumentPack<Arguments...>&>(arguments).arguments);
+    }
+};
+
+template <typename Function, std::size_t... Index>
+auto functionSignature(std::index_sequence<Index...>)
+    -> typename function_traits<Function>::return_type(*)(typename function_traits<Function>::template argument<Index>::type...);
+
+template <typename Function, typename Signature = decltype(functionSignature<Function>(std::make_index_sequence<function_traits<Function>::arity>()))>
+class SharedFunctor;
+
+/// Forwards the invocation to a shared functor. The callable of a functor connection holds this
+/// forwarder, so the functor state is not split between the callable and the typed slot.
+template <typename Function, typename Ret, typename... Arguments>
+class SharedFunctor<Function, Ret(*)(Arguments...)>
+{
+    std::shared_ptr<Function> m_function;
+
+public:
+    explicit SharedFunctor(std::shared_ptr<Function> function = nullptr)
+        : m_function(std::move(function))
+    {
+    }
+
+    Ret operator()(Arguments... arguments) const
+    {
+        return (*m_function)(std::forward<Arguments>(arguments)...);
+    }
+};
+
+/// Creates the callable of a \a slot connected to a signal. A functor slot is invoked through its
+/// shared \a function instance. When \a function is \e nullptr, the callable is only good for
+/// comparison.
+template <typename Function>
+Callable createSlotCallable(const Function& slot, std::shared_ptr<Function> function)
+{
+    if constexpr (function_traits<Function>::type == FunctionType::Functor)
+    {
+        UNUSED(slot);
+        return Callable(SharedFunctor<Function>(std::move(function)));
+    }
+    else
+    {
+        UNUSED(function);
+        return Callable(slot);
+    }
+}
+
+template <typename Method, typename Signature>
+class MethodTypedSlot;
+
+/// Typed slot of a method.
+template <typename Method, typename... Arguments>
+class MethodTypedSlot<Method, std::tuple<Arguments...>> : public Signal::TypedSlot
+{
+    using Receiver = typename function_traits<Method>::object;
+
+    Receiver* m_receiver;
+    Method m_method;
+
+public:
+    explicit MethodTypedSlot(Receiver& receiver, Method method)
+        : Signal::TypedSlot(typeid(std::tuple<Arguments...>))
+        , m_receiver(&receiver)
+        , m_method(method)
+    {
+    }
+
+    void invoke(const Signal::TypedArguments& arguments) override
+    {
+        auto invoker = [receiver = m_receiver, method = m_method](const Arguments&... args)
+        {
+            (receiver->*method)(args...);
+        };
+        std::apply(invoker, static_cast<const Signal::TypedArgumentPack<Arguments...>&>(arguments).arguments);
+    }
+};
+
+/// Tests whether a \a Function is invocable with the \a Prefix arguments followed by the const
+/// references of the \a Arguments.
+template <typename Function, typename... Prefix, typename... Arguments>
+constexpr bool isTypedInvocable(std::tuple<Arguments...>*)
+{
+    return std::is_invocable_v<Function, Prefix..., const Arguments&...>;
+}
+
+/// Creates a typed slot for a function, functor or lambda. Returns \e nullptr if the slot takes
+/// arguments by non-const reference.
+template <typename Function>
+Signal::TypedSlotPtr createTypedSlot(std::shared_ptr<Function> function)
+{
+    using Signature = TypedSignature<Function>;
+    if constexpr (isTypedInvocable<Function&>(static_cast<Signature*>(nullptr)))
+    {
+        return std::make_unique<FunctionTypedSlot<Function, Signature>>(std::move(function));
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+/// Creates a typed slot for a \a method of a \a receiver. Returns \e nullptr if the method takes
+/// arguments by non-const reference.
+template <typename Method>
+Signal::TypedSlotPtr createTypedSlot(typename function_traits<Method>::object& receiver, Method method)
+{
+    using Signature = TypedSignature<Method>;
+    using Receiver = typename function_traits<Method>::object;
+    if constexpr (isTypedInvocable<Method, Receiver*>(static_cast<Signature*>(nullptr)))
+    {
+        return std::make_unique<MethodTypedSlot<Method, Signature>>(receiver, method);
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+/// Returns the MetaBase of a \a receiver, or \e nullptr if the receiver is not a MetaBase.
+template <typename Receiver>
+MetaBase* receiverHost(Receiver& receiver)
+{
+    if constexpr (std::is_base_of_v<MetaBase, Receiver>)
+    {
+        return const_cast<std::remove_const_t<Receiver>*>(&receiver);
+    }
+    else
+    {
+        UNUSED(receiver);
+        return nullptr;
+    }
+}
+
+} // namespace signal_detail
+
+template <typename... Arguments>
+Signal::TypedArgumentPack<Arguments...>::TypedArgumentPack(const Arguments&... arguments)
+    : TypedArguments(typeid(std::tuple<Arguments...>), sizeof...(Arguments))
+    , arguments(arguments...)
+{
+}
+
+template <typename... Arguments>
+Callable::ArgumentPack Signal::TypedArgumentPack<Arguments...>::pack() const
+{
+    auto packer = [](const Arguments&... args)
+    {
+        return Callable::ArgumentPack(args...);
+    };
+    return std::apply(packer, arguments);
+}
+
 template <class Derived, typename... Arguments>
 Signal::ConnectionSharedPtr Signal::Connection::create(Signal& sender, Arguments&&... args)
 {
-    auto connection = make_polymorphic_shared<Connection, Derived>(sender, std::forward<Arguments>(args)...);
+    static_assert(std::is_base_of_v<Connection, Derived>, "Connection is not a superclass of Derived.");
+    ConnectionSharedPtr connection = std::allocate_shared<Derived>(Allocator<Derived>(), sender, std::forward<Arguments>(args)...);
     sender.addConnection(connection);
     return connection;
 }
@@ -37,14 +222,14 @@ Signal::ConnectionSharedPtr Signal::Connection::create(Signal& sender, Arguments
  */
 template <typename SlotFunction>
 std::enable_if_t<std::is_member_function_pointer_v<SlotFunction>, Signal::ConnectionSharedPtr>
-Signal::connect(typename function_traits<SlotFunction>::object& receiver, SlotFunction method)
+Signal::connect(typename function_traits<SlotFunction>::object& receiver, SlotFunction method, ConnectionType type)
 {
     Callable slotCallable(method);
     if (!slotCallable.isInvocableWith(getType()->getArguments()))
     {
         return nullptr;
     }
-    return connect(Variant(&receiver), std::forward<Callable>(slotCallable));
+    return connect(Variant(&receiver), std::forward<Callable>(slotCallable), signal_detail::createTypedSlot(receiver, method), signal_detail::receiverHost(receiver), type);
 }
 
 template <typename SlotFunction>
@@ -52,7 +237,7 @@ std::enable_if_t<std::is_member_function_pointer_v<SlotFunction>, bool>
 Signal::disconnect(typename function_traits<SlotFunction>::object& receiver, SlotFunction method)
 {
     Variant receiverInstance(&receiver);
-    return disconnectImpl(receiverInstance, Callable(method));
+    return disconnectImpl(receiverInstance, Callable(method), signal_detail::receiverHost(receiver));
 }
 
 /******************************************************************************
@@ -62,19 +247,21 @@ template <typename Function>
 std::enable_if_t<!std::is_base_of_v<Signal, Function>, Signal::ConnectionSharedPtr>
 Signal::connect(const Function& slot)
 {
-    Callable lambda(slot);
+    using SlotType = std::decay_t<Function>;
+    auto function = std::make_shared<SlotType>(slot);
+    Callable lambda = signal_detail::createSlotCallable<SlotType>(slot, function);
     if (!lambda.isInvocableWith(getType()->getArguments()))
     {
         return nullptr;
     }
-    return connect(std::forward<Callable>(lambda));
+    return connect(std::forward<Callable>(lambda), signal_detail::createTypedSlot(std::move(function)));
 }
 
 template <typename Function>
 std::enable_if_t<!std::is_base_of_v<Signal, Function>, bool>
 Signal::disconnect(const Function& slot)
 {
-    return disconnectImpl(Variant(), Callable(slot));
+    return disconnectImpl(Variant(), signal_detail::createSlotCallable<std::decay_t<Function>>(slot, nullptr));
 }
 
 template <typename... Arguments>
@@ -83,7 +270,7 @@ int Signal::operator()(Arguments... arguments)
 #ifdef DEBUG
     FATAL(getType()->getArguments().isInvocableWithArgumentTypes<Arguments...>(), "Signal arguments and signal type arguments mismatch");
 #endif
-    return activate(Callable::ArgumentPack(arguments...));
+    return activate(TypedArgumentPack<Arguments...>(arguments...));
 }
 
 } // namespace mox
@@ -23,14 +23,23 @@
 #include <mox/config/pimpl.hpp>
 #include <mox/utils/locks.hpp>
 #include <mox/utils/containers/shared_vector.hpp>
+#include <mox/core/meta/base/metabase.hpp>
 #include <mox/core/meta/core/callable.hpp>
 #include <mox/core/meta/signal/signal_type.hpp>
 #include <mox/utils/function_traits.hpp>
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <tuple>
+#include <typeinfo>
+
 namespace mox
 {
 
 class SignalType;
+class SignalStorage;
+class MetaBasePrivate;
 
 /// Signal defines the signals in your class, and holds the connections made against the
 /// signal. You can connect a signal to a method, a metamethod, a function, a functor or
@@ -46,7 +55,12 @@ class SignalType;
 /// When the object to which the signal belongs is destroyed, all the signal connections are
 /// also disconnected. All asynchronous connections are marked as invalid, so when scheduled,
 /// those will not get processed.
-class SignalStorage;
+///
+/// Connections to the slots of a MetaBase receiver are registered to the receiver. When the
+/// receiver is destroyed, these connections are disconnected from their signals.
+///
+/// The signal creates its storage on the first connection. Activating a signal with no storage
+/// returns without invoking any slot.
 class MOX_API Signal : public SharedLock<MetaBase>
 {
 public:
@@ -54,6 +68,90 @@ public:
     /// The connection type.
     using ConnectionSharedPtr = std::shared_ptr<Connection>;
 
+    /// The types of the connections to the methods of objects.
+    enum class ConnectionType
+    {
+        /// The slot is invoked directly if the receiver object lives in the thread of the signal
+        /// activation, otherwise the slot is deferred to the thread of the receiver.
+        Auto,
+        /// Same as Auto, except that the activation of a deferred slot waits till the thread of the
+        /// receiver completes the slot. Do not use it between threads that wait on each other.
+        BlockingQueued
+    };
+
+    /// The arguments of a typed signal emission. The arguments are passed to the slots in their
+    /// native types, and are packed into a Callable::ArgumentPack only when a connection that
+    /// cannot take the native arguments gets activated.
+    class MOX_API TypedArguments
+    {
+    public:
+        /// Destructor.
+        virtual ~TypedArguments() = default;
+
+        /// Packs the native arguments into an argument pack.
+        /// \return The argument pack with the arguments.
+        virtual Callable::ArgumentPack pack() const = 0;
+
+        /// The signature of the arguments, the type info of the tuple of the argument types.
+        const std::type_info& signature;
+        /// The number of arguments.
+        const std::size_t count;
+
+    protected:
+        /// Constructs the typed arguments with the \a signature and the \a count of arguments.
+        explicit TypedArguments(const std::type_info& signature, std::size_t count)
+            : signature(signature)
+            , count(count)
+        {
+        }
+    };
+
+    /// Holds the native arguments of a signal emission.
+    template <typename... Arguments>
+    class TypedArgumentPack : public TypedArguments
+    {
+    public:
+        /// Constructs the typed argument pack referencing the \a arguments.
+        explicit TypedArgumentPack(const Arguments&... arguments);
+
+        Callable::ArgumentPack pack() const override;
+
+        /// The arguments.
+        std::tuple<const Arguments&...> arguments;
+    };
+
+    /// A typed slot is a slot which is invoked with the native arguments of a typed signal emission,
+    /// bypassing the Variant argument packing. A typed slot is created when the slot connected is a
+    /// function, functor, lambda or method that takes its arguments by value or by const reference.
+    class MOX_API TypedSlot
+    {
+    public:
+        /// Destructor.
+        virtual ~TypedSlot() = default;
+
+        /// Invokes the slot with the \a arguments. The arguments must have the same signature as
+        /// the slot.
+        virtual void invoke(const TypedArguments& arguments) = 0;
+
+        /// Tests whether the slot can be invoked with the \a arguments.
+        bool isInvocableWith(const TypedArguments& arguments) const
+        {
+            return signature == arguments.signature;
+        }
+
+        /// The signature of the slot arguments.
+        const std::type_info& signature;
+
+    protected:
+        /// Constructs the typed slot with the \a signature.
+        explicit TypedSlot(const std::type_info& signature)
+            : signature(signature)
+        {
+        }
+    };
+    /// The typed slot pointer type.
+    using TypedSlotPtr = std::unique_ptr<TypedSlot>;
+
     /// The class represents a connection to a signal. The connection is a token which holds
     /// the signal connected, and the slot the signal is connected to. The slot is a function,
     /// a method, a metamethod, a functor or a lambda.
@@ -64,7 +162,7 @@ public:
         static ConnectionSharedPtr create(Signal& sender, Arguments&&... args);
 
         /// Destructor.
-        virtual ~Connection() = default;
+        virtual ~Connection();
 
         /// Returns the state of the connection.
         /// \return If the connection is connected, \e true, otherwise \e false.
@@ -85,13 +183,68 @@ public:
         static ConnectionSharedPtr getActiveConnection();
 
     protected:
-        /// Constructs a connection attached to the \a signal.
-        explicit Connection(Signal& signal);
+        /// Allocator of the connections. A connection and its shared state are allocated in a
+        /// single block, reusing the blocks released earlier on the allocating thread.
+        template <typename Type>
+        struct Allocator
+        {
+            using value_type = Type;
+
+            Allocator() = default;
+            template <typename Other>
+            Allocator(const Allocator<Other>&)
+            {
+            }
+
+            Type* allocate(std::size_t count)
+            {
+                return static_cast<Type*>(allocateBlock(count * sizeof(Type)));
+            }
+            void deallocate(Type* block, std::size_t count)
+            {
+                releaseBlock(block, count * sizeof(Type));
+            }
+
+            template <typename Other>
+            bool operator==(const Allocator<Other>&) const
+            {
+                return true;
+            }
+            template <typename Other>
+            bool operator!=(const Allocator<Other>&) const
+            {
+                return false;
+            }
+        };
+        /// Allocates a block of \a size bytes for a connection.
+        static void* allocateBlock(std::size_t size);
+        /// Releases a connection \a block of \a size bytes.
+        static void releaseBlock(void* block, std::size_t size);
+
+        /// Constructs a connection attached to the \a signal. If the slot of the connection
+        /// belongs to a \a receiver host, the connection is registered to the receiver, which
+        /// disconnects it on destruction.
+        explicit Connection(Signal& signal, MetaBase* receiver = nullptr);
+
+        /// Returns the receiver signal of a connection between two signals.
+        /// \return The receiver signal, \e nullptr if the slot of the connection is not a signal.
+        virtual Signal* receiverSignal() const;
+
+        /// Tests whether the slot of the connection is bound to the thread of its receiver. Parallel
+        /// activations activate the thread bound connections on the activating thread.
+        /// \return If the connection is bound to a thread, \e true, otherwise \e false.
+        virtual bool isThreadBound() const;
 
         /// Activates the connection by calling the slot of the connection.
         /// \param args The arguments to pass to the slot.
         virtual void activate(const Callable::ArgumentPack& args) = 0;
 
+        /// Activates the connection with the native arguments of a typed emission.
+        /// \param args The native arguments to pass to the slot.
+        /// \return If the connection was able to consume the native arguments, \e true, otherwise
+        /// \e false, in which case the connection must be activated with the packed arguments.
+        virtual bool activateTyped(const TypedArguments& args);
+
         /// Resets the connection.
         virtual void invalidate();
 
@@ -101,11 +254,22 @@ public:
         virtual bool disconnect(Variant receiver, const Callable& callable) = 0;
 
         /// The signal the connection is attached to.
-        Signal* m_signal = nullptr;
+        std::atomic<Signal*> m_signal = nullptr;
+        /// Set while a receiver being destroyed removes the connection from its signal. The signal
+        /// waits for the removal before it gets destroyed, and other disconnects leave the
+        /// connection to that receiver.
+        std::atomic_bool m_signalClaimed = false;
+        /// The host of the slot, \e nullptr if the connection is not registered to a receiver.
+        std::atomic<MetaBase*> m_receiverHost = nullptr;
+        /// The siblings of the connection in the registry of the receiver.
+        Connection* m_prevInbound = nullptr;
+        Connection* m_nextInbound = nullptr;
 
         friend class Signal;
+        friend class MetaBasePrivate;
         friend class SignalStorage;
         friend class DeferredSignalEvent;
+        friend class DeferredSignalBatchEvent;
     };
 
     /// Constructs the signal.
@@ -120,11 +284,36 @@ public:
 
     /// Activates the connections of the signal by invoking the slots from each connection passing
     /// the \a arguments to the slots. Connections created during the activation are not invoked
-    /// in the same activation cycle.
+    /// in the same activation cycle. The signal can be activated from several threads at the same
+    /// time, however a signal activated from its own slots on the same thread is not re-activated.
     /// \param arguments The arguments to pass to the slots, being the arguments passed to the signal.
     /// \return The number of connections activated.
     int activate(const Callable::ArgumentPack& arguments);
 
+    /// Activates the connections of the signal with native arguments. Connections with a slot
+    /// which has the same signature as the \a arguments are invoked directly. The arguments are
+    /// packed for the rest of the connections, once per activation.
+    /// \param arguments The native arguments to pass to the slots.
+    /// \return The number of connections activated.
+    int activate(const TypedArguments& arguments);
+
+    /// The join handle of a parallel activation. The handle gets ready when all the connections
+    /// of the activation complete, and holds the number of connections activated.
+    using ParallelActivation = std::future<int>;
+
+    /// Activates the connections of the signal in parallel, on a pool of worker threads. The slots
+    /// bound to the thread of an object receiver, and the connected signals, are activated on the
+    /// calling thread the same way activate() does, so deferred slots stay deferred. The rest of
+    /// the connections are split into contiguous ranges, and each range is activated on a worker
+    /// in connection order. There is no ordering between the ranges, and between the ranges and
+    /// the thread bound connections. Use it only for slots that do independent work.
+    ///
+    /// A parallel activation called from a worker activates its connections on the worker.
+    /// \param arguments The arguments to pass to the slots.
+    /// \return The join handle of the activation. If a slot throws, the handle rethrows the first
+    /// exception.
+    ParallelActivation activateParallel(Callable::ArgumentPack arguments);
+
     /// Creates a connection between this signal and a receiver \a signal.
     /// \param signal The receiver signal connected to this signal.
     /// \return The connection shared object.
@@ -138,11 +327,12 @@ public:
     /// Connects a \a method of a \a receiver to this signal.
     /// \param receiver The receiver of the connection.
     /// \param method The method to connect.
+    /// \param type The connection type, applies when the receiver is an Object.
     /// \return If the connection succeeds, returns the shared pointer to the connection. If the connection
     /// fails, returns \e nullptr.
     template <typename SlotFunction>
     std::enable_if_t<std::is_member_function_pointer_v<SlotFunction>, ConnectionSharedPtr>
-    connect(typename function_traits<SlotFunction>::object& receiver, SlotFunction method);
+    connect(typename function_traits<SlotFunction>::object& receiver, SlotFunction method, ConnectionType type = ConnectionType::Auto);
     /// Disconnects a \a method that is a method of the \a receiver.
     /// \param receiver The receiver of the connection.
     /// \param methodName The name of the metamethod to connect.
@@ -167,6 +357,14 @@ public:
     std::enable_if_t<!std::is_base_of_v<Signal, Function>, bool>
     disconnect(const Function& slot);
 
+    /// Tests whether the signal has connections to activate. The test does not lock the host,
+    /// so use it to skip preparing the arguments of an activation that would invoke no slots.
+    /// \return If the signal has connections, and is not blocked, returns \e true, otherwise \e false.
+    bool hasConnections() const
+    {
+        return m_hasConnections.load(std::memory_order_acquire) && !m_blocked.load(std::memory_order_relaxed);
+    }
+
     /// Returns the blocked state of a signal.
     /// \return If the signal is blocked, returns \e true, otherwise \e false.
     bool isBlocked() const;
@@ -174,8 +372,9 @@ public:
     /// \param blocked Pass \e true to block the signal, \e false to unblock it.
     void setBlocked(bool blocked);
 
-    /// Signal emitter. Packs the \a arguments into a Callable::ArgumentPack pack and activates
-    /// the signal connections.
+    /// Signal emitter. Activates the signal connections with the \a arguments. Slots with the
+    /// same signature as the arguments are invoked directly, the rest of the slots are invoked
+    /// with the arguments packed into a Callable::ArgumentPack.
     /// \param arguments... The variadic arguments passed.
     /// \return The number of connections activated.
     template <typename... Arguments>
@@ -191,16 +390,51 @@ protected:
     /// Removes a \a connection from the signal.
     void removeConnection(ConnectionSharedPtr connection);
 
-    /// Creates a connection to a \a lambda. The connection owns the callable.
-    ConnectionSharedPtr connect(Callable&& lambda);
-    /// Creates a connection to a \a receiver and a \a slot. The connection owns the callable.
-    ConnectionSharedPtr connect(Variant receiver, Callable&& slot);
-
-    /// Disconnects a connection that holds a \a receiver and \a callableAddress.
-    bool disconnectImpl(Variant receiver, const Callable& callable);
-
-    DECLARE_PRIVATE(SignalStorage)
-    pimpl::d_ptr_type<SignalStorage> d_ptr;
+    /// Creates a connection to a \a lambda. The connection owns the callable, and the optional
+    /// \a typedSlot.
+    ConnectionSharedPtr connect(Callable&& lambda, TypedSlotPtr typedSlot = nullptr);
+    /// Creates a connection to a \a receiver and a \a slot. The connection owns the callable, and
+    /// the optional \a typedSlot. When the receiver is a MetaBase, pass it as \a receiverHost to
+    /// register the connection to the receiver. The connection \a type applies to Object receivers.
+    ConnectionSharedPtr connect(Variant receiver, Callable&& slot, TypedSlotPtr typedSlot = nullptr, MetaBase* receiverHost = nullptr, ConnectionType type = ConnectionType::Auto);
+
+    /// Activates the connections using the \a activator, when the signal is activated with
+    /// \a argumentCount arguments.
+    template <typename Activator>
+    int activateConnections(std::size_t argumentCount, Activator&& activator);
+
+    /// Disconnects a connection that holds a \a receiver and \a callableAddress. When the receiver
+    /// is a MetaBase, pass it as \a receiverHost to look up the connection in the registry of the
+    /// receiver instead of the connections of the signal.
+    bool disconnectImpl(Variant receiver, const Callable& callable, MetaBase* receiverHost = nullptr);
+
+    /// Returns the storage of the signal, and creates it if the signal has no storage yet. The
+    /// caller must hold the host lock.
+    SignalStorage* ensureStorage();
+
+    inline SignalStorage* d_func()
+    {
+        return d_ptr.load(std::memory_order_acquire);
+    }
+    inline const SignalStorage* d_func() const
+    {
+        return d_ptr.load(std::memory_order_acquire);
+    }
+    friend class SignalStorage;
+    friend class MetaBasePrivate;
+
+    /// The signal type.
+    const SignalType& m_type;
+    /// The next signal of the host.
+    Signal* m_nextSignal = nullptr;
+    /// The signal storage, \e nullptr till the signal gets connected.
+    std::atomic<SignalStorage*> d_ptr = nullptr;
+    /// The signal activation is blocked.
+    std::atomic_bool m_blocked = false;
+    /// The signal has connections.
+    std::atomic_bool m_hasConnections = false;
+    /// The signal is attached to its host.
+    bool m_attached = true;
 };
 
 class MOX_API SignalBlocker
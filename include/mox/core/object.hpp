@@ -185,6 +185,14 @@ public:
     /// Returns the thread data of this object.
     ThreadDataSharedPtr threadData() const;
 
+    /// Checks whether the object belongs to the calling thread. Unlike comparing threadData()
+    /// results, the check does not share the thread data.
+    /// \return If the object belongs to the calling thread, returns \e true, otherwise \e false.
+    bool isInThisThread() const
+    {
+        return ThreadData::isThisThread(m_threadData.get());
+    }
+
 protected:
     /// Constructor.
     explicit Object();
@@ -55,6 +55,13 @@ public:
     /// Returns the main thread data.
     static ThreadDataSharedPtr getMainThreadData();
 
+    /// Checks whether the \a threadData is the thread data of this thread. The check does not
+    /// share the thread data of this thread.
+    /// \param threadData The thread data to check, \e nullptr to check whether this thread has
+    /// no thread data.
+    /// \return If the \a threadData belongs to this thread, returns \e true, otherwise \e false.
+    static bool isThisThread(const ThreadData* threadData);
+
     /// Checks whether the thread data is the main thread's data.
     /// \return If the thread data belongs to the main thread, returns \e true, otherwise \e false.
     bool isMainThread() const;
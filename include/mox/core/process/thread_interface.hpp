@@ -178,6 +178,34 @@ static bool postEvent(TargetPtr target, Arguments&&... args)
     return postEvent(std::move(event));
 }
 
+/// Invokes a \a callable with \a arguments on the thread of the \a target. When called from the
+/// thread of the \a target, the callable is invoked before the function returns.
+/// \param target The object on which thread the callable is invoked.
+/// \param callable The callable to invoke.
+/// \param arguments The arguments of the callable. If the callable is a method, the first
+/// argument is the instance.
+/// \return The future of the invocation result. If the invocation cannot be posted to the thread
+/// of the \a target, the future reports a broken promise.
+MOX_API DeferredInvocationEvent::Future invokeOn(ObjectSharedPtr target, Callable&& callable, Callable::ArgumentPack&& arguments);
+
+/// Template function, invokes a \a function with \a arguments on the thread of the \a target. If
+/// the function is a method, it is invoked on the \a target.
+/// \return The future of the invocation result.
+template <typename Function, typename... Arguments>
+std::enable_if_t<!std::is_same_v<std::decay_t<Function>, Callable>, DeferredInvocationEvent::Future>
+invokeOn(ObjectSharedPtr target, Function function, Arguments... arguments)
+{
+    if constexpr (std::is_member_function_pointer_v<Function>)
+    {
+        Object* instance = target.get();
+        return invokeOn(target, Callable(function), Callable::ArgumentPack(instance, arguments...));
+    }
+    else
+    {
+        return invokeOn(target, Callable(function), Callable::ArgumentPack(arguments...));
+    }
+}
+
 }
 
 DECLARE_LOG_CATEGORY(threads)
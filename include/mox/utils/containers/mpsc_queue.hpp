@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2017-2019 bitWelder
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see
+ * <http://www.gnu.org/licenses/>
+ */
+
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace mox
+{
+
+/// MpscQueue is an unbounded, lock-free multiple producer, single consumer FIFO queue. Any number
+/// of threads can push values to the queue concurrently, without blocking each other. The values
+/// must be popped from a single consumer thread. With one producer the queue serves as a single
+/// producer, single consumer mailbox.
+///
+/// A push that is in progress while the consumer pops may be observed only by the next pop. Pair
+/// the queue with an atomic flag to wake the consumer only once per batch of values.
+/// \tparam T The value type stored in the queue.
+template <typename T>
+class MpscQueue
+{
+    struct Node
+    {
+        std::atomic<Node*> next = nullptr;
+        std::optional<T> value;
+    };
+
+    std::atomic<Node*> m_head;
+    Node* m_tail = nullptr;
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+public:
+    /// Constructor.
+    explicit MpscQueue()
+    {
+        m_tail = new Node;
+        m_head.store(m_tail, std::memory_order_relaxed);
+    }
+    /// Destructor. Destroys the values left in the queue.
+    ~MpscQueue()
+    {
+        clear();
+        delete m_tail;
+    }
+
+    /// Pushes a \a value to the queue. You can call this method from any thread.
+    /// \param value The value to push.
+    void push(T value)
+    {
+        auto node = new Node;
+        node->value.emplace(std::move(value));
+        auto previous = m_head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /// Pops the value from the front of the queue. Call this method only from the consumer thread.
+    /// \param[out] value The value popped.
+    /// \return If a value is popped, returns \e true. If the queue is empty, returns \e false.
+    bool pop(T& value)
+    {
+        auto next = m_tail->next.load(std::memory_order_acquire);
+        if (!next)
+        {
+            return false;
+        }
+        value = std::move(*next->value);
+        next->value.reset();
+        delete m_tail;
+        m_tail = next;
+        return true;
+    }
+
+    /// Checks whether the queue is empty. Call this method only from the consumer thread.
+    /// \return If the queue has no values to pop, returns \e true, otherwise \e false.
+    bool empty() const
+    {
+        return m_tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    /// Pops and destroys all the values from the queue. Call this method only from the consumer
+    /// thread.
+    void clear()
+    {
+        auto next = m_tail->next.load(std::memory_order_acquire);
+        while (next)
+        {
+            delete m_tail;
+            m_tail = next;
+            m_tail->value.reset();
+            next = m_tail->next.load(std::memory_order_acquire);
+        }
+    }
+};
+
+} // namespace mox
+
+#endif // MPSC_QUEUE_HPP
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2017-2020 bitWelder
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see
+ * <http://www.gnu.org/licenses/>
+ */
+
+#ifndef SHARED_BUFFER_HPP
+#define SHARED_BUFFER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mox
+{
+
+/// SharedBuffer is an immutable buffer, which shares its data between its copies. Pass large data
+/// through variants, signals and threads as shared buffers to avoid copying the data.
+template <typename Type>
+class SharedBuffer
+{
+public:
+    /// The container of the buffer data.
+    using Container = std::vector<Type>;
+    /// The iterator of the buffer.
+    using const_iterator = typename Container::const_iterator;
+
+    /// Constructs an empty buffer.
+    SharedBuffer() = default;
+
+    /// Constructs the buffer taking the \a data.
+    explicit SharedBuffer(Container&& data)
+        : m_data(std::make_shared<const Container>(std::move(data)))
+    {
+    }
+
+    /// Constructs the buffer with a copy of the \a data.
+    explicit SharedBuffer(const Container& data)
+        : m_data(std::make_shared<const Container>(data))
+    {
+    }
+
+    /// Returns the container of the buffer data.
+    const Container& get() const
+    {
+        static const Container empty;
+        return m_data ? *m_data : empty;
+    }
+
+    /// Returns the pointer to the buffer data.
+    const Type* data() const
+    {
+        return get().data();
+    }
+
+    /// Returns the number of elements in the buffer.
+    std::size_t size() const
+    {
+        return get().size();
+    }
+
+    /// Returns \e true if the buffer has no elements.
+    bool empty() const
+    {
+        return get().empty();
+    }
+
+    const_iterator begin() const
+    {
+        return get().begin();
+    }
+
+    const_iterator end() const
+    {
+        return get().end();
+    }
+
+    const Type& operator[](std::size_t index) const
+    {
+        return get()[index];
+    }
+
+    /// Compares the data of two buffers.
+    bool operator==(const SharedBuffer& other) const
+    {
+        return (m_data == other.m_data) || (get() == other.get());
+    }
+
+    bool operator!=(const SharedBuffer& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    std::shared_ptr<const Container> m_data;
+};
+
+/// The shared buffer of 32 bit integers.
+using Int32Buffer = SharedBuffer<int32_t>;
+
+} // mox
+
+#endif // SHARED_BUFFER_HPP
@@ -18,6 +18,11 @@
 
 #include <mox/core/event_handling/event.hpp>
 #include <mox/core/object.hpp>
+#include <mox/core/process/thread_interface.hpp>
+
+#include <mox/utils/containers/mpsc_queue.hpp>
+
+#include <unordered_map>
 
 namespace mox
 {
@@ -101,10 +106,10 @@ int QuitEvent::getExitCode() const
 /******************************************************************************
  * DeferredSignalEvent
  */
-DeferredSignalEvent::DeferredSignalEvent(ObjectSharedPtr target, Signal::Connection& connection, const Callable::ArgumentPack& args)
+DeferredSignalEvent::DeferredSignalEvent(ObjectSharedPtr target, Signal::Connection& connection, Callable::ArgumentPack args)
     : Event(target, EventType::DeferredSignal, Priority::Urgent)
     , m_connection(connection.shared_from_this())
-    , m_arguments(args)
+    , m_arguments(std::move(args))
 {
     FATAL(target, "Cannot post deferred call on a null target");
 }
@@ -120,4 +125,203 @@ void DeferredSignalEvent::activate()
     }
 }
 
+/******************************************************************************
+ * DeferredInvocationEvent
+ */
+DeferredInvocationEvent::DeferredInvocationEvent(ObjectSharedPtr target, Callable&& callable, Callable::ArgumentPack&& arguments)
+    : Event(target, EventType::DeferredInvocation, Priority::Urgent)
+    , m_callable(std::move(callable))
+    , m_arguments(std::move(arguments))
+{
+    FATAL(target, "Cannot post deferred invocation on a null target");
+}
+
+bool DeferredInvocationEvent::isCompressible() const
+{
+    return false;
+}
+
+DeferredInvocationEvent::Future DeferredInvocationEvent::getFuture()
+{
+    return m_result.get_future();
+}
+
+void DeferredInvocationEvent::activate()
+{
+    CTRACE(event, "Invoke callable for target" << target());
+    try
+    {
+        m_result.set_value(m_callable.apply(m_arguments));
+    }
+    catch (...)
+    {
+        m_result.set_exception(std::current_exception());
+    }
+}
+
+/******************************************************************************
+ * DeferredSignalMailbox
+ */
+class DeferredSignalMailbox : public std::enable_shared_from_this<DeferredSignalMailbox>
+{
+public:
+    struct Activation
+    {
+        Signal::ConnectionSharedPtr connection;
+        Callable::ArgumentPack arguments;
+    };
+
+    explicit DeferredSignalMailbox(ThreadDataSharedPtr thread)
+        : m_thread(thread)
+    {
+    }
+
+    ThreadDataSharedPtr thread() const
+    {
+        return m_thread.lock();
+    }
+
+    // Queues an activation. Returns true if the caller must schedule a batch for the mailbox.
+    bool push(Signal::Connection& connection, Callable::ArgumentPack&& args)
+    {
+        m_pending.push({connection.shared_from_this(), std::move(args)});
+        return !m_scheduled.exchange(true);
+    }
+
+    // Re-arms the mailbox for the next batch. The activations queued after the re-arm either get
+    // taken by the current batch, or schedule a new one.
+    void rearm()
+    {
+        m_scheduled.store(false);
+    }
+
+    // Takes the next pending activation. Only the receiving thread takes activations.
+    bool take(Activation& activation)
+    {
+        return m_pending.pop(activation);
+    }
+
+    // Re-arms the mailbox of a batch that is never going to be dispatched. The pending activations
+    // are dropped only on the receiving thread, elsewhere the next batch takes them, or they are
+    // destroyed with the mailbox.
+    void discard()
+    {
+        auto thread = m_thread.lock();
+        if (thread && ThreadData::isThisThread(thread.get()))
+        {
+            m_pending.clear();
+        }
+        rearm();
+    }
+
+private:
+    MpscQueue<Activation> m_pending;
+    ThreadDataWeakPtr m_thread;
+    std::atomic_bool m_scheduled = false;
+};
+
+namespace
+{
+
+// The mailboxes of the emitting thread, keyed by the receiving thread data.
+thread_local std::unordered_map<const ThreadData*, DeferredSignalMailboxPtr> threadMailboxes;
+
+DeferredSignalMailboxPtr getMailbox(ThreadData& receiverThread)
+{
+    auto it = threadMailboxes.find(&receiverThread);
+    if (it != threadMailboxes.end() && it->second->thread().get() == &receiverThread)
+    {
+        return it->second;
+    }
+
+    // Drop the mailboxes of the threads that are gone.
+    for (auto mit = threadMailboxes.begin(); mit != threadMailboxes.end();)
+    {
+        mit = mit->second->thread() ? std::next(mit) : threadMailboxes.erase(mit);
+    }
+
+    auto mailbox = std::make_shared<DeferredSignalMailbox>(receiverThread.shared_from_this());
+    threadMailboxes[&receiverThread] = mailbox;
+    return mailbox;
+}
+
+}
+
+/******************************************************************************
+ * DeferredSignalBatchEvent
+ */
+DeferredSignalBatchEvent::DeferredSignalBatchEvent(ObjectSharedPtr target, DeferredSignalMailboxPtr mailbox)
+    : Event(target, EventType::DeferredSignalBatch, Priority::Urgent)
+    , m_mailbox(mailbox)
+{
+    FATAL(m_mailbox, "Cannot post deferred batch without a mailbox");
+}
+
+DeferredSignalBatchEvent::~DeferredSignalBatchEvent()
+{
+    if (m_mailbox)
+    {
+        m_mailbox->discard();
+    }
+}
+
+bool DeferredSignalBatchEvent::isCompressible() const
+{
+    return false;
+}
+
+void DeferredSignalBatchEvent::activate()
+{
+    auto mailbox = std::move(m_mailbox);
+    if (!mailbox)
+    {
+        return;
+    }
+    CTRACE(event, "Asynchronously activate a batch of connections");
+    mailbox->rearm();
+    DeferredSignalMailbox::Activation activation;
+    while (mailbox->take(activation))
+    {
+        if (!activation.connection->isConnected())
+        {
+            continue;
+        }
+        // The activations of a batch are independent, a failing slot must not hold back the rest.
+        try
+        {
+            activation.connection->activate(activation.arguments);
+        }
+        catch (std::exception& e)
+        {
+            CWARN(event, "Deferred slot failed: " << e.what());
+        }
+        catch (...)
+        {
+            CWARN(event, "Deferred slot failed.");
+        }
+    }
+}
+
+bool DeferredSignalBatchEvent::post(ObjectSharedPtr receiver, Signal::Connection& connection, Callable::ArgumentPack args)
+{
+    FATAL(receiver, "Cannot post deferred call on a null receiver");
+    auto td = receiver->threadData();
+    if (!td)
+    {
+        CWARN(event, "receiver is not in a thread");
+        return false;
+    }
+
+    auto mailbox = getMailbox(*td);
+    if (!mailbox->push(connection, std::move(args)))
+    {
+        // A batch is already scheduled for the mailbox.
+        return true;
+    }
+
+    auto thread = td->thread();
+    FATAL(thread, "No thread!");
+    return postEvent<DeferredSignalBatchEvent>(thread, mailbox);
+}
+
 } // mox
@@ -42,21 +42,58 @@ void EventQueue::clear()
     lock_guard lock(*this);
     // Access the container to wipe the queue.
     c.clear();
+    EventPtr event;
+    while (m_postedEvents.pop(event))
+    {
+        m_postedCount.fetch_sub(1u, std::memory_order_relaxed);
+    }
 }
 
 size_t EventQueue::size() const
 {
-    return EventQueueBase::size();
+    lock_guard lock(const_cast<EventQueue&>(*this));
+    return EventQueueBase::size() + m_postedCount.load(std::memory_order_acquire);
 }
 
 bool EventQueue::empty() const
 {
-    return EventQueueBase::empty();
+    return size() == 0u;
 }
 
 void EventQueue::push(EventPtr event)
 {
+    event->markTimestamp();
     lock_guard lock(*this);
+    enqueue(std::move(event));
+}
+
+bool EventQueue::post(EventPtr event)
+{
+    event->markTimestamp();
+    m_postedEvents.push(std::move(event));
+    m_postedCount.fetch_add(1u, std::memory_order_release);
+    return !m_wakeUpPending.exchange(true);
+}
+
+void EventQueue::cancelWakeUp()
+{
+    m_wakeUpPending.store(false);
+}
+
+void EventQueue::fetchPostedEvents()
+{
+    // Re-arm the wakeup before fetching, so the events posted after the fetch wake the consumer.
+    m_wakeUpPending.store(false);
+    EventPtr event;
+    while (m_postedEvents.pop(event))
+    {
+        m_postedCount.fetch_sub(1u, std::memory_order_relaxed);
+        enqueue(std::move(event));
+    }
+}
+
+void EventQueue::enqueue(EventPtr event)
+{
     if (event->isCompressible())
     {
         // loop through the container and find out if compression is needed
@@ -73,7 +110,6 @@ void EventQueue::push(EventPtr event)
     }
 
     // No compression is required, proceed with push.
-    event->markTimestamp();
     EventQueueBase::emplace(std::move(event));
 }
 
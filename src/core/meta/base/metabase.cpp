@@ -20,6 +20,12 @@
 #include <signal_p.hpp>
 #include <mox/core/meta/property/property.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
 namespace mox
 {
 
@@ -33,18 +39,244 @@ void MetaBasePrivate::invalidateDynamicProperties()
     std::for_each(dynamicProperties.begin(), dynamicProperties.end(), invalidate);
 }
 
-void MetaBasePrivate::addSignal(SignalStorage& storage)
+void MetaBasePrivate::addSignal(Signal& signal)
 {
-    signals.insert(std::make_pair(&storage.getType(), &storage));
+    signal.m_nextSignal = signals;
+    signals = &signal;
 }
 
-void MetaBasePrivate::removeSignal(SignalStorage* storage)
+void MetaBasePrivate::removeSignal(Signal& signal)
 {
-    if (!storage)
+    // The signals are removed in reverse order of their addition, so the signal is usually the first.
+    for (auto link = &signals; *link; link = &(*link)->m_nextSignal)
+    {
+        if (*link == &signal)
+        {
+            *link = signal.m_nextSignal;
+            signal.m_nextSignal = nullptr;
+            return;
+        }
+    }
+}
+
+Signal* MetaBasePrivate::findSignal(const SignalType& type) const
+{
+    for (auto signal = signals; signal; signal = signal->m_nextSignal)
+    {
+        if (&signal->m_type == &type)
+        {
+            return signal;
+        }
+    }
+    return nullptr;
+}
+
+void MetaBasePrivate::linkConnection(MetaBase& receiver, Signal::Connection& connection)
+{
+    auto d = get(receiver);
+    std::lock_guard<std::mutex> lock(d->inboundLock);
+    connection.m_prevInbound = nullptr;
+    connection.m_nextInbound = d->inboundConnections;
+    if (d->inboundConnections)
+    {
+        d->inboundConnections->m_prevInbound = &connection;
+    }
+    d->inboundConnections = &connection;
+    connection.m_receiverHost.store(&receiver, std::memory_order_release);
+}
+
+void MetaBasePrivate::unlinkConnection(Signal::Connection& connection)
+{
+    // Taking the receiver from the connection makes this call responsible for the removal. The
+    // receiver waits for the removal before it gets destroyed, so it is safe to lock it.
+    auto receiver = connection.m_receiverHost.exchange(nullptr, std::memory_order_acq_rel);
+    if (!receiver)
     {
         return;
     }
-    signals.erase(&storage->getType());
+    auto d = get(*receiver);
+    std::lock_guard<std::mutex> lock(d->inboundLock);
+    d->removeInboundConnection(connection);
+}
+
+void MetaBasePrivate::removeInboundConnection(Signal::Connection& connection)
+{
+    if (connection.m_prevInbound)
+    {
+        connection.m_prevInbound->m_nextInbound = connection.m_nextInbound;
+    }
+    else
+    {
+        inboundConnections = connection.m_nextInbound;
+    }
+    if (connection.m_nextInbound)
+    {
+        connection.m_nextInbound->m_prevInbound = connection.m_prevInbound;
+    }
+    connection.m_prevInbound = connection.m_nextInbound = nullptr;
+}
+
+std::vector<Signal::ConnectionSharedPtr> MetaBasePrivate::getInboundConnections(const Signal& sender) const
+{
+    std::vector<Signal::ConnectionSharedPtr> result;
+    std::lock_guard<std::mutex> lock(inboundLock);
+    for (auto connection = inboundConnections; connection; connection = connection->m_nextInbound)
+    {
+        if (connection->m_signal != &sender)
+        {
+            continue;
+        }
+        // Skip the connections which are being destroyed.
+        auto shared = connection->weak_from_this().lock();
+        if (shared)
+        {
+            result.push_back(std::move(shared));
+        }
+    }
+    return result;
+}
+
+template <typename Predicate>
+std::vector<Signal::ConnectionSharedPtr> MetaBasePrivate::takeInboundConnections(Predicate predicate, bool takeDestroyed)
+{
+    std::vector<Signal::ConnectionSharedPtr> result;
+    std::unique_lock<std::mutex> lock(inboundLock);
+    auto connection = inboundConnections;
+    while (connection)
+    {
+        auto next = connection->m_nextInbound;
+        auto prev = connection->m_prevInbound;
+        // A connection which is being destroyed has no shared pointer, and its slot must not be
+        // touched. It stays valid till it is in the registry.
+        auto shared = connection->weak_from_this().lock();
+        if (shared ? !predicate(*shared) : !takeDestroyed)
+        {
+            connection = next;
+            continue;
+        }
+
+        auto receiver = p_ptr;
+        if (!connection->m_receiverHost.compare_exchange_strong(receiver, nullptr, std::memory_order_acq_rel))
+        {
+            // The connection is being unlinked, which removes it from the registry. Let that
+            // complete, and restart the scan.
+            lock.unlock();
+            std::this_thread::yield();
+            lock.lock();
+            connection = inboundConnections;
+            continue;
+        }
+
+        // A destroyed connection may be gone once its receiver is reset, so unlink it through
+        // its siblings only.
+        if (prev)
+        {
+            prev->m_nextInbound = next;
+        }
+        else
+        {
+            inboundConnections = next;
+        }
+        if (next)
+        {
+            next->m_prevInbound = prev;
+        }
+        if (shared)
+        {
+            shared->m_prevInbound = shared->m_nextInbound = nullptr;
+            result.push_back(std::move(shared));
+        }
+        connection = next;
+    }
+    return result;
+}
+
+void MetaBasePrivate::removeFromSignals(std::vector<Signal::ConnectionSharedPtr>& connections)
+{
+    // Claim the signal of each connection, so a signal destroyed on another thread waits for the
+    // removal. A connection whose signal is already reset is skipped, its signal is gone. Group the
+    // claimed connections by their signal, so each signal publishes a single new snapshot.
+    using SignalConnection = std::pair<Signal*, Signal::ConnectionSharedPtr>;
+    std::vector<SignalConnection> grouped;
+    grouped.reserve(connections.size());
+    for (auto& connection : connections)
+    {
+        connection->m_signalClaimed = true;
+        auto signal = connection->m_signal.exchange(nullptr);
+        if (signal)
+        {
+            grouped.emplace_back(signal, connection);
+        }
+        else
+        {
+            connection->m_signalClaimed = false;
+        }
+    }
+    auto bySignal = [](const SignalConnection& lhs, const SignalConnection& rhs)
+    {
+        return std::less<Signal*>()(lhs.first, rhs.first);
+    };
+    std::sort(grouped.begin(), grouped.end(), bySignal);
+
+    std::vector<Signal::ConnectionSharedPtr> matches;
+    for (auto first = grouped.begin(); first != grouped.end();)
+    {
+        auto last = std::upper_bound(first, grouped.end(), *first, bySignal);
+        auto signal = first->first;
+
+        matches.clear();
+        std::transform(first, last, std::back_inserter(matches), [](auto& entry) { return entry.second; });
+        {
+            lock_guard lock(*signal);
+            auto d = signal->d_func();
+            if (d)
+            {
+                d->removeConnections(matches);
+            }
+            for (auto& connection : matches)
+            {
+                connection->invalidate();
+            }
+        }
+        // The signal may be destroyed once the claims are released.
+        for (auto& connection : matches)
+        {
+            connection->m_signalClaimed = false;
+        }
+        first = last;
+    }
+}
+
+void MetaBasePrivate::disconnectInboundConnections()
+{
+    auto all = [](Signal::Connection&)
+    {
+        return true;
+    };
+    auto connections = takeInboundConnections(all, true);
+
+    // Disconnecting locks the senders, so do that without holding the registry.
+    removeFromSignals(connections);
+}
+
+void MetaBasePrivate::disconnectSignalConnections(const Signal& receiverSignal)
+{
+    auto isToSignal = [&receiverSignal](Signal::Connection& connection)
+    {
+        return connection.receiverSignal() == &receiverSignal;
+    };
+    // The connections being destroyed unlink themselves, and no longer activate the signal.
+    auto connections = takeInboundConnections(isToSignal, false);
+
+    removeFromSignals(connections);
+    for (auto& connection : connections)
+    {
+        if (connection->receiverSignal())
+        {
+            // The sender is gone, the connection only needs to drop the receiver signal.
+            connection->invalidate();
+        }
+    }
 }
 
 void MetaBasePrivate::addProperty(PropertyStorage& storage)
@@ -80,6 +312,9 @@ MetaBase::MetaBase()
 
 MetaBase::~MetaBase()
 {
+    // Disconnect the slots of the object from the signals which outlive it.
+    d_ptr->disconnectInboundConnections();
+
     auto dynamicPropertyCount = d_ptr->dynamicProperties.size();
     // Remove dynamic properties. This shall decrease the reference count to the MetaBase.
     d_ptr->invalidateDynamicProperties();
@@ -130,6 +365,9 @@ bool MetaBase::try_lock()
 
 MetaBase::~MetaBase()
 {
+    // Disconnect the slots of the object from the signals which outlive it.
+    d_ptr->disconnectInboundConnections();
+
     // Remove dynamic properties. This shall decrease the reference count to the MetaBase.
     d_ptr->invalidateDynamicProperties();
 }
@@ -154,10 +392,7 @@ bool MetaBase::try_lock()
 Signal* MetaBase::findSignal(const SignalType& type) const
 {
     D();
-    auto it = d->signals.find(&type);
-    return (it != d->signals.end())
-            ? it->second->getSignal()
-            : nullptr;
+    return d->findSignal(type);
 }
 
 Signal* MetaBase::addSignal(const SignalType& type)
@@ -21,6 +21,10 @@
 #include <signal_p.hpp>
 #include <mox/core/object.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+
 namespace mox
 {
 namespace metainfo
@@ -31,7 +35,7 @@ AbstractMetaInfo::AbstractMetaInfo(std::string_view name)
 {
 }
 
-std::string AbstractMetaInfo::name() const
+const std::string& AbstractMetaInfo::name() const
 {
     return m_name;
 }
@@ -43,7 +47,7 @@ MetaClass::MetaSignalBase::MetaSignalBase(MetaClass& hostClass, VariantDescripto
     : SignalType(std::forward<VariantDescriptorContainer>(args))
     , AbstractMetaInfo(name)
 {
-    hostClass.addMetaSignal(*this);
+    hostClass.addMember(*this);
 }
 
 std::string MetaClass::MetaSignalBase::signature() const
@@ -72,7 +76,7 @@ MetaClass::MetaPropertyBase::MetaPropertyBase(MetaClass& hostClass, VariantDescr
     : PropertyType(std::forward<VariantDescriptor>(typeDes), access, signal, defaultValue)
     , AbstractMetaInfo(name)
 {
-    hostClass.addMetaProperty(*this);
+    hostClass.addMember(*this);
 }
 
 std::string MetaClass::MetaPropertyBase::signature() const
@@ -109,25 +113,49 @@ void MetaClass::addMetaMethod(Callable& method)
 {
     auto metaMethod = dynamic_cast<MetaMethodBase*>(&method);
     FATAL(metaMethod, "You can only add MetaMethods to a MetaClass.");
-    m_metaMethods.push_back(metaMethod);
+    addMember(*metaMethod);
 }
 
 void MetaClass::addMetaSignal(SignalType& signal)
 {
     auto metaSignal = dynamic_cast<MetaSignalBase*>(&signal);
     FATAL(metaSignal, "You can only add MetaSignals to a MetaClass.");
-    m_metaSignals.push_back(metaSignal);
+    addMember(*metaSignal);
 }
 
 void MetaClass::addMetaProperty(PropertyType& property)
 {
     auto metaProperty = dynamic_cast<MetaPropertyBase*>(&property);
     FATAL(metaProperty, "You can only add MetaProperty to a MetaClass.");
-    m_metaProperties.push_back(metaProperty);
+    addMember(*metaProperty);
+}
+
+void MetaClass::addMember(const MetaMethodBase& method)
+{
+    FATAL(!m_membersFrozen, "Cannot add members to a metaclass after a lookup by member name.");
+    m_metaMethods.push_back(&method);
+}
+
+void MetaClass::addMember(const MetaSignalBase& signal)
+{
+    FATAL(!m_membersFrozen, "Cannot add members to a metaclass after a lookup by member name.");
+    m_metaSignals.push_back(&signal);
+}
+
+void MetaClass::addMember(const MetaPropertyBase& property)
+{
+    FATAL(!m_membersFrozen, "Cannot add members to a metaclass after a lookup by member name.");
+    m_metaProperties.push_back(&property);
+}
+
+namespace
+{
+std::atomic_size_t metaClassCount = 0u;
 }
 
 MetaClass::MetaClass(std::pair<Metatype, Metatype> type)
     : m_type(type)
+    , m_classIndex(metaClassCount++)
 {
     MetaData::addMetaClass(*this);
 }
@@ -144,16 +172,37 @@ bool MetaClass::isSuperClassOf(const MetaClass &metaClass) const
 
 bool MetaClass::derivesFrom(const MetaClass &metaClass) const
 {
-    auto deriveTester = [&metaClass](const MetaClass& mc) -> VisitorResultType
+    if (&metaClass == this)
+    {
+        return true;
+    }
+    const auto& ancestors = getAncestors();
+    const auto word = metaClass.m_classIndex / 64u;
+    return (word < ancestors.size()) && (ancestors[word] & (uint64_t(1) << (metaClass.m_classIndex % 64u)));
+}
+
+const std::vector<uint64_t>& MetaClass::getAncestors() const
+{
+    // The superclasses of a static metaclass are constructed on demand, so the ancestors are
+    // collected on the first test.
+    std::call_once(m_ancestorsBuilt, [this]()
     {
-        if (&mc == &metaClass)
+        auto collector = [this](const MetaClass& mc) -> VisitorResultType
         {
-            return std::make_tuple(MetaClass::Abort, &mc);
-        }
-        return std::make_tuple(MetaClass::Continue, MetaValue());
-    };
-    // Visitor aborts if the metaclass is derived from a superclass.
-    return std::get<0>(visit(MetaClassVisitor(deriveTester))) == Abort;
+            if (&mc != this)
+            {
+                const auto word = mc.m_classIndex / 64u;
+                if (word >= m_ancestors.size())
+                {
+                    m_ancestors.resize(word + 1u, 0u);
+                }
+                m_ancestors[word] |= uint64_t(1) << (mc.m_classIndex % 64u);
+            }
+            return std::make_tuple(Continue, MetaValue());
+        };
+        visit(MetaClassVisitor(collector));
+    });
+    return m_ancestors;
 }
 
 const MetaClass* MetaClass::find(std::string_view className)
@@ -239,19 +288,98 @@ const PropertyType* MetaClass::visitProperties(const PropertyVisitor& visitor) c
             : nullptr;
 }
 
+/******************************************************************************
+ * MetaClass name index
+ */
+struct MetaClass::NameIndex
+{
+    template <class Member>
+    using Index = std::unordered_map<std::string_view, std::vector<const Member*>>;
+
+    Index<Callable> methods;
+    Index<SignalType> signals;
+    Index<PropertyType> properties;
+
+    template <class Member, class MetaMember>
+    static void add(Index<Member>& index, const MetaMember* member)
+    {
+        // Diamond inheritance visits a superclass more than once.
+        auto& list = index[member->name()];
+        if (std::find(list.begin(), list.end(), member) == list.end())
+        {
+            list.push_back(member);
+        }
+    }
+
+    template <class Member>
+    static const std::vector<const Member*>& find(const Index<Member>& index, std::string_view name)
+    {
+        static const std::vector<const Member*> notFound;
+        auto it = index.find(name);
+        return (it != index.end()) ? it->second : notFound;
+    }
+};
+
+const MetaClass::NameIndex& MetaClass::getNameIndex() const
+{
+    // The members of a static metaclass are only complete after its construction, so the index
+    // is built on the first lookup. The index is never rebuilt, and the indexed metaclasses
+    // refuse further members.
+    std::call_once(m_nameIndexBuilt, [this]()
+    {
+        auto index = std::make_unique<NameIndex>();
+        auto indexer = [&index](const MetaClass& mc) -> VisitorResultType
+        {
+            // The index holds the members of the superclasses too, so those are frozen as well.
+            mc.m_membersFrozen = true;
+            for (auto method : mc.m_metaMethods)
+            {
+                NameIndex::add(index->methods, method);
+            }
+            for (auto signal : mc.m_metaSignals)
+            {
+                NameIndex::add(index->signals, signal);
+            }
+            for (auto property : mc.m_metaProperties)
+            {
+                NameIndex::add(index->properties, property);
+            }
+            return std::make_tuple(Continue, MetaValue());
+        };
+        visit(MetaClassVisitor(indexer));
+        m_nameIndex = std::move(index);
+    });
+    return *m_nameIndex;
+}
+
+const MetaClass::MethodList& MetaClass::findMethods(std::string_view name) const
+{
+    return NameIndex::find(getNameIndex().methods, name);
+}
+
+const MetaClass::SignalList& MetaClass::findSignals(std::string_view name) const
+{
+    return NameIndex::find(getNameIndex().signals, name);
+}
+
+const MetaClass::PropertyList& MetaClass::findProperties(std::string_view name) const
+{
+    return NameIndex::find(getNameIndex().properties, name);
+}
+
 /******************************************************************************
  * meta
  */
-Signal::ConnectionSharedPtr connect(Signal& signal, MetaBase& receiver, const Callable& metaMethod)
+Signal::ConnectionSharedPtr connect(Signal& signal, MetaBase& receiver, const Callable& metaMethod, Signal::ConnectionType type)
 {
     Object* recv = dynamic_cast<Object*>(&receiver);
     if (recv)
     {
-        return Signal::Connection::create<ObjectMetaMethodConnection>(signal, *recv, metaMethod);
+        return Signal::Connection::create<ObjectMetaMethodConnection>(signal, *recv, metaMethod, type);
     }
     else
     {
-        return Signal::Connection::create<MetaMethodConnection>(signal, Variant(&receiver), metaMethod);
+        return Signal::Connection::create<MetaMethodConnection>(signal, receiver, metaMethod);
     }
 }
 
@@ -26,6 +26,7 @@
 
 #include <mox/utils/function_traits.hpp>
 #include <mox/config/string.hpp>
+#include <mox/utils/containers/shared_buffer.hpp>
 
 #include <sstream>
 
@@ -105,6 +106,16 @@ std::string literalToString(std::string_view value)
     return value.data();
 }
 
+Int32Buffer vectorToBuffer(std::vector<int32_t> vector)
+{
+    return Int32Buffer(std::move(vector));
+}
+
+std::vector<int32_t> bufferToVector(Int32Buffer buffer)
+{
+    return buffer.get();
+}
+
 // Registrar function
 void MetaData::registerConverters()
 {
@@ -195,6 +206,9 @@ void MetaData::registerConverters()
     registerStringConverter<double>();
     // literal to string
     registerConverter<std::string_view, std::string>(literalToString);
+    // vector and shared buffer
+    registerConverter<std::vector<int32_t>, Int32Buffer>(vectorToBuffer);
+    registerConverter<Int32Buffer, std::vector<int32_t>>(bufferToVector);
 }
 
 } // namespace mox
@@ -25,6 +25,7 @@
 
 #include <mox/utils/function_traits.hpp>
 #include <mox/core/meta/signal/signal.hpp>
+#include <mox/utils/containers/shared_buffer.hpp>
 
 #include <mox/utils/log/logger.hpp>
 
@@ -116,10 +117,10 @@ bool MetatypeDescriptor::isSupertypeOf(const MetatypeDescriptor& type) const
         return false;
     }
 
-    const auto* thisClass = MetaData::getMetaClass(m_id);
+    const auto* thisClass = m_metaClass.load(std::memory_order_acquire);
     FATAL(thisClass, "No MetaClass for the class type.");
 
-    const auto* typeClass = MetaData::getMetaClass(type.id());
+    const auto* typeClass = type.m_metaClass.load(std::memory_order_acquire);
     FATAL(typeClass, "No MetaClass for the class type.");
     return thisClass->isSuperClassOf(*typeClass);
 }
@@ -131,10 +132,10 @@ bool MetatypeDescriptor::derivesFrom(const MetatypeDescriptor& type) const
         return false;
     }
 
-    const auto* thisClass = MetaData::getMetaClass(m_id);
+    const auto* thisClass = m_metaClass.load(std::memory_order_acquire);
     FATAL(thisClass, "No MetaClass for the class type.");
 
-    const auto* typeClass = MetaData::getMetaClass(type.id());
+    const auto* typeClass = type.m_metaClass.load(std::memory_order_acquire);
     FATAL(typeClass, "No MetaClass for the class type.");
     return thisClass->derivesFrom(*typeClass);
 }
@@ -181,11 +182,7 @@ const std::type_info* MetatypeDescriptor::rtti() const
 
 const MetatypeDescriptor::Converter* MetatypeDescriptor::findConverterTo(Metatype target) const
 {
-    auto i = m_converters.find(target);
-    if (i == m_converters.cend())
-        return nullptr;
-    else
-        return &i->second;
+    return MetaData::findConverter(m_id, target);
 }
 
 bool MetatypeDescriptor::registerConverter(Converter&& converter, Metatype fromType, Metatype toType)
@@ -196,15 +193,17 @@ bool MetatypeDescriptor::registerConverter(Converter&& converter, Metatype fromT
 
 const MetatypeDescriptor::Converter* MetatypeDescriptor::findConverter(Metatype fromType, Metatype toType)
 {
-    MetatypeDescriptor& fromTypeDes = MetaData::getMetaType(fromType);
-    return fromTypeDes.findConverterTo(toType);
+    return MetaData::findConverter(fromType, toType);
 }
 
 bool MetatypeDescriptor::addConverter(Converter&& converter, Metatype target)
 {
+    FATAL(MetaData::globalMetaDataPtr, "mox is not initialized or down.");
+    lock_guard locker(*MetaData::globalMetaDataPtr);
     if (m_converters.find(target) == m_converters.end())
     {
         m_converters.insert({target, std::forward<Converter>(converter)});
+        MetaData::invalidateConverters();
         return true;
     }
     return false;
@@ -232,9 +231,12 @@ void MetaData::registerAtomicTypes()
     ATOMIC_TYPE("double", double, Metatype::Double)
 
 #ifdef LONG_SYNONIM_OF_UINT64
-    synonymTypes.push_back(std::make_pair(&typeid(intptr_t), Metatype::Int64));
-    synonymTypes.push_back(std::make_pair(&typeid(long), Metatype::Int64));
-    synonymTypes.push_back(std::make_pair(&typeid(unsigned long), Metatype::UInt64));
+    {
+        lock_guard locker(*this);
+        metaTypeIndex.insert({std::type_index(typeid(intptr_t)), Metatype::Int64});
+        metaTypeIndex.insert({std::type_index(typeid(long)), Metatype::Int64});
+        metaTypeIndex.insert({std::type_index(typeid(unsigned long)), Metatype::UInt64});
+    }
 #endif
 
     ATOMIC_TYPE("std::string", std::string, Metatype::String)
@@ -244,6 +246,7 @@ void MetaData::registerAtomicTypes()
     ATOMIC_TYPE("int*", int32_t*, Metatype::Int32Ptr)
     ATOMIC_TYPE("int64*", int64_t*, Metatype::Int64Ptr)
     ATOMIC_TYPE("vector<int32>", std::vector<int32_t>, Metatype::Int32Vector)
+    ATOMIC_TYPE("buffer<int32>", Int32Buffer, Metatype::Int32Buffer)
 }
 
 }// namespace mox
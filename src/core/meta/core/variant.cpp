@@ -23,32 +23,39 @@
 
 #include <algorithm>
 
-namespace std
+namespace mox
 {
 
-void swap(mox::Variant& lhs, mox::Variant& rhs)
+Variant::~Variant()
 {
-    lhs.swap(rhs);
-}
-
+    reset();
 }
 
-namespace mox
-{
-
 Variant::Variant(const Variant& other)
-    : m_data(other.m_data)
+    : m_vtable(other.m_vtable)
+    , m_typeDescriptor(other.m_typeDescriptor)
 {
+    if (m_vtable)
+    {
+        m_vtable->copy(m_storage, other.m_storage);
+    }
 }
 
-Variant::Variant(Variant&& other)
+Variant::Variant(Variant&& other) noexcept
+    : m_vtable(other.m_vtable)
+    , m_typeDescriptor(other.m_typeDescriptor)
 {
-    swap(other);
+    if (m_vtable)
+    {
+        m_vtable->move(m_storage, other.m_storage);
+        other.m_vtable = nullptr;
+        other.m_typeDescriptor = VariantDescriptor();
+    }
 }
 
-Variant& Variant::operator=(Variant&& other)
+Variant& Variant::operator=(Variant&& other) noexcept
 {
-    Variant(other).swap(*this);
+    Variant(std::move(other)).swap(*this);
     return *this;
 }
 
@@ -61,36 +68,55 @@ Variant& Variant::operator=(const Variant& other)
 
 bool Variant::isValid() const
 {
-    return m_data && m_data->m_value.has_value();
+    return m_vtable != nullptr;
 }
 
 void Variant::reset()
 {
-    m_data.reset();
+    if (m_vtable)
+    {
+        m_vtable->destroy(m_storage);
+        m_vtable = nullptr;
+        m_typeDescriptor = VariantDescriptor();
+    }
 }
 
 Metatype Variant::metaType() const
 {
-    FATAL(m_data, "Variant is not initialized.");
-    return m_data->m_typeDescriptor.getType();
+    FATAL(m_vtable, "Variant is not initialized.");
+    return m_typeDescriptor.getType();
 }
 
 const VariantDescriptor& Variant::descriptor() const
 {
-    FATAL(m_data, "Variant is not initialized.");
-    return m_data->m_typeDescriptor;
+    FATAL(m_vtable, "Variant is not initialized.");
+    return m_typeDescriptor;
 }
 
-void Variant::swap(Variant &other)
+void Variant::swap(Variant &other) noexcept
 {
-    std::swap(m_data, other.m_data);
+    Storage tmp;
+    if (m_vtable)
+    {
+        m_vtable->move(tmp, m_storage);
+    }
+    if (other.m_vtable)
+    {
+        other.m_vtable->move(m_storage, other.m_storage);
+    }
+    if (m_vtable)
+    {
+        m_vtable->move(other.m_storage, tmp);
+    }
+    std::swap(m_vtable, other.m_vtable);
+    m_typeDescriptor.swap(other.m_typeDescriptor);
 }
 
 bool operator==(const Variant &var1, const Variant &var2)
 {
-    if (var1.isValid() && var2.isValid() && (var1.m_data->m_typeDescriptor == var2.m_data->m_typeDescriptor))
+    if (var1.isValid() && var2.isValid() && (var1.m_typeDescriptor == var2.m_typeDescriptor))
     {
-        return var1.m_data->m_isEqual(*var2.m_data);
+        return var1.m_vtable->equals(var1.m_storage, var2.m_storage);
     }
 
     return false;
@@ -178,12 +204,17 @@ void VariantDescriptor::swap(VariantDescriptor& other)
 }
 
 bool VariantDescriptorContainer::isInvocableWith(const VariantDescriptorContainer &other) const
+{
+    return isInvocableWith(other.m_container.data(), other.m_container.data() + other.m_container.size());
+}
+
+bool VariantDescriptorContainer::isInvocableWith(const VariantDescriptor* begin, const VariantDescriptor* end) const
 {
     auto callableStart = m_container.begin();
     auto callableEnd = m_container.cend();
 
-    auto paramStart = other.m_container.cbegin();
-    auto paramEnd = other.m_container.cend();
+    auto paramStart = begin;
+    auto paramEnd = end;
 
     while (callableStart != callableEnd && paramStart != paramEnd && callableStart->invocableWith(*paramStart))
     {
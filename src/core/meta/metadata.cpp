@@ -24,6 +24,7 @@
 #include <mox/config/string.hpp>
 #include <mox/core/meta/core/variant.hpp>
 #include <algorithm>
+#include <utility>
 
 #ifdef MOX_ENABLE_LOGS
 #include <mox/utils/log/logger.hpp>
@@ -48,13 +49,47 @@ MetaData::~MetaData()
     globalMetaDataPtr = nullptr;
 }
 
+MetaData::MetatypeTable::~MetatypeTable()
+{
+    for (auto& chunk : m_chunks)
+    {
+        delete chunk.load(std::memory_order_relaxed);
+    }
+}
+
+void MetaData::MetatypeTable::append(MetatypeDescriptor* descriptor)
+{
+    const auto index = m_size.load(std::memory_order_relaxed);
+    FATAL(index < ChunkSize * MaxChunks, "Metatype table is full.");
+    auto& chunk = m_chunks[index / ChunkSize];
+    if (!chunk.load(std::memory_order_relaxed))
+    {
+        chunk.store(new Chunk{}, std::memory_order_release);
+    }
+    (*chunk.load(std::memory_order_relaxed))[index % ChunkSize].store(descriptor, std::memory_order_release);
+    m_size.store(index + 1u, std::memory_order_release);
+}
+
 const MetatypeDescriptor& MetaData::addMetaType(const char* name, const std::type_info& rtti, bool isEnum, bool isClass, bool isPointer)
 {
     FATAL(globalMetaDataPtr, "mox is not initialized or down.");
     lock_guard locker(*globalMetaDataPtr);
+    return globalMetaDataPtr->appendMetaType(name, rtti, isEnum, isClass, isPointer);
+}
 
-    globalMetaDataPtr->metaTypes.emplace_back(new MetatypeDescriptor(name, int(globalMetaDataPtr->metaTypes.size()), rtti, isEnum, isClass, isPointer));
-    return *globalMetaDataPtr->metaTypes.back().get();
+const MetatypeDescriptor& MetaData::appendMetaType(const char* name, const std::type_info& rtti, bool isEnum, bool isClass, bool isPointer)
+{
+    auto type = static_cast<Metatype>(metaTypes.size());
+    metaTypes.emplace_back(new MetatypeDescriptor(name, int(type), rtti, isEnum, isClass, isPointer));
+    metaTypeTable.append(metaTypes.back().get());
+    metaTypeIndex.insert({std::type_index(rtti), type});
+    return *metaTypes.back().get();
+}
+
+MetatypeDescriptor* MetaData::findMetaType(const std::type_info& rtti)
+{
+    auto it = metaTypeIndex.find(std::type_index(rtti));
+    return (it != metaTypeIndex.end()) ? metaTypes[static_cast<size_t>(it->second)].get() : nullptr;
 }
 
 namespace metadata
@@ -87,23 +122,7 @@ MetatypeDescriptor* findMetatypeDescriptor(const std::type_info& rtti)
         return nullptr;
     }
     lock_guard locker(*MetaData::globalMetaDataPtr);
-
-    for (auto& type : MetaData::globalMetaDataPtr->metaTypes)
-    {
-        if (type->rtti()->hash_code() == rtti.hash_code())
-        {
-            return type.get();
-        }
-    }
-    // Find synonym types.
-    for (auto& synonym : MetaData::globalMetaDataPtr->synonymTypes)
-    {
-        if (synonym.first->hash_code() == rtti.hash_code())
-        {
-            return MetaData::globalMetaDataPtr->metaTypes[static_cast<size_t>(synonym.second)].get();
-        }
-    }
-    return nullptr;
+    return MetaData::globalMetaDataPtr->findMetaType(rtti);
 }
 
 Metatype findMetatype(const std::type_info& rtti)
@@ -122,11 +141,12 @@ Metatype tryRegisterMetatype(const std::type_info &rtti, bool isEnum, bool isCla
         metadata.registerConverters();
     }
 
-    const MetatypeDescriptor* type = findMetatypeDescriptor(rtti);
+    // Look up and add under the same lock, so concurrent registrations of a type resolve to the same metatype.
+    lock_guard locker(metadata);
+    const MetatypeDescriptor* type = metadata.findMetaType(rtti);
     if (!type)
     {
-        const MetatypeDescriptor& newType = MetaData::addMetaType(name.data(), rtti, isEnum, isClass, isPointer);
-        type = &newType;
+        type = &metadata.appendMetaType(name.data(), rtti, isEnum, isClass, isPointer);
     }
     return type->id();
 }
@@ -144,6 +164,7 @@ const MetaClass* find(std::function<bool(const MetaClass&)> predicate)
         return nullptr;
     }
     lock_guard locker(*MetaData::globalMetaDataPtr);
+    MetaData::globalMetaDataPtr->registerPendingMetaClasses();
 
     for (auto& metaclass : MetaData::globalMetaDataPtr->metaClasses)
     {
@@ -161,24 +182,90 @@ const MetaClass* find(std::function<bool(const MetaClass&)> predicate)
 MetatypeDescriptor& MetaData::getMetaType(Metatype type)
 {
     FATAL(globalMetaDataPtr, "mox is not initialized or down.");
-    lock_guard locker(*globalMetaDataPtr);
-    FATAL(static_cast<size_t>(type) < globalMetaDataPtr->metaTypes.size(), "Type not registered to be reflectable.");
-    return *globalMetaDataPtr->metaTypes[static_cast<size_t>(type)].get();
+    const auto index = static_cast<size_t>(type);
+    FATAL(index < globalMetaDataPtr->metaTypeTable.size(), "Type not registered to be reflectable.");
+    return *globalMetaDataPtr->metaTypeTable.get(index);
 }
 
-void MetaData::addMetaClass(const metainfo::MetaClass& metaClass)
+const MetatypeDescriptor::Converter* MetaData::findConverter(Metatype fromType, Metatype toType)
 {
     FATAL(globalMetaDataPtr, "mox is not initialized or down.");
-    std::string name = MetatypeDescriptor::get(metaClass.getMetaTypes().first).name();
+    auto& metaData = *globalMetaDataPtr;
+    while (true)
+    {
+        auto table = metaData.converterTable.load(std::memory_order_acquire);
+        if (table)
+        {
+            return table->find(fromType, toType);
+        }
+        metaData.rebuildConverterTable();
+    }
+}
 
-    lock_guard locker(*globalMetaDataPtr);
-    auto it = globalMetaDataPtr->metaClasses.find(name);
-    FATAL(it == globalMetaDataPtr->metaClasses.cend(), "Static metaclass for '" + name + "' already registered!");
+void MetaData::invalidateConverters()
+{
+    FATAL(globalMetaDataPtr, "mox is not initialized or down.");
+    globalMetaDataPtr->converterTable.store(nullptr, std::memory_order_release);
+}
+
+void MetaData::rebuildConverterTable()
+{
+    lock_guard locker(*this);
+    if (converterTable.load(std::memory_order_acquire))
+    {
+        // Rebuilt by an other thread.
+        return;
+    }
 
-    globalMetaDataPtr->metaClassRegister.insert({metaClass.getMetaTypes().first, &metaClass});
-    globalMetaDataPtr->metaClasses.insert({name, &metaClass});
+    auto newTable = std::make_unique<ConverterTable>();
+    newTable->rows.reserve(metaTypes.size());
+    for (auto& type : metaTypes)
+    {
+        size_t extent = 0u;
+        for (auto& converter : type->m_converters)
+        {
+            extent = std::max(extent, static_cast<size_t>(converter.first) + 1u);
+        }
+        newTable->rows.emplace_back(newTable->cells.size(), extent);
+        newTable->cells.resize(newTable->cells.size() + extent, nullptr);
+        for (auto& converter : type->m_converters)
+        {
+            newTable->cells[newTable->rows.back().first + static_cast<size_t>(converter.first)] = &converter.second;
+        }
+    }
 
-    CTRACE(metacore, "MetaClass added:" << name);
+    CTRACE(metacore, "Converter table rebuilt with" << newTable->cells.size() << "cells");
+    converterTable.store(newTable.get(), std::memory_order_release);
+    // Readers may still use the superseded tables, so those are kept until the metadata is gone.
+    converterTables.push_back(std::move(newTable));
+}
+
+void MetaData::addMetaClass(const metainfo::MetaClass& metaClass)
+{
+    FATAL(globalMetaDataPtr, "mox is not initialized or down.");
+    auto& type = getMetaType(metaClass.getMetaTypes().first);
+    const metainfo::MetaClass* expected = nullptr;
+    const bool added = type.m_metaClass.compare_exchange_strong(expected, &metaClass, std::memory_order_acq_rel);
+    FATAL(added, "Static metaclass for '" << type.name() << "' already registered!");
+
+    auto& pending = globalMetaDataPtr->pendingMetaClasses;
+    metaClass.m_nextPending = pending.load(std::memory_order_relaxed);
+    while (!pending.compare_exchange_weak(metaClass.m_nextPending, &metaClass, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+
+    CTRACE(metacore, "MetaClass added:" << type.name());
+}
+
+void MetaData::registerPendingMetaClasses()
+{
+    auto metaClass = pendingMetaClasses.exchange(nullptr, std::memory_order_acquire);
+    while (metaClass)
+    {
+        std::string name = MetatypeDescriptor::get(metaClass->getMetaTypes().first).name();
+        metaClasses.insert({name, metaClass});
+        metaClass = std::exchange(metaClass->m_nextPending, nullptr);
+    }
 }
 
 void MetaData::removeMetaClass(const metainfo::MetaClass& metaClass)
@@ -191,16 +278,14 @@ void MetaData::removeMetaClass(const metainfo::MetaClass& metaClass)
     std::string name = MetatypeDescriptor::get(metaClass.getMetaTypes().first).name();
 
     lock_guard locker(*globalMetaDataPtr);
+    globalMetaDataPtr->registerPendingMetaClasses();
     auto it = globalMetaDataPtr->metaClasses.find(name);
     if (it != globalMetaDataPtr->metaClasses.cend())
     {
-        globalMetaDataPtr->metaClasses.erase(it, it);
-    }
-    auto cit = globalMetaDataPtr->metaClassRegister.find(metaClass.getMetaTypes().first);
-    if (cit != globalMetaDataPtr->metaClassRegister.cend())
-    {
-        globalMetaDataPtr->metaClassRegister.erase(cit, cit);
+        globalMetaDataPtr->metaClasses.erase(it, it + 1);
     }
+    const metainfo::MetaClass* expected = &metaClass;
+    getMetaType(metaClass.getMetaTypes().first).m_metaClass.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
 
     CTRACE(metacore, "MetaClass" << name << "removed");
 }
@@ -209,6 +294,7 @@ const metainfo::MetaClass* MetaData::findMetaClass(std::string_view name)
 {
     FATAL(globalMetaDataPtr, "mox is not initialized or down.");
     lock_guard locker(*globalMetaDataPtr);
+    globalMetaDataPtr->registerPendingMetaClasses();
     auto it = globalMetaDataPtr->metaClasses.find(std::string(name));
     return it != globalMetaDataPtr->metaClasses.cend() ? it->second : nullptr;
 }
@@ -216,9 +302,12 @@ const metainfo::MetaClass* MetaData::findMetaClass(std::string_view name)
 const metainfo::MetaClass* MetaData::getMetaClass(Metatype metaType)
 {
     FATAL(globalMetaDataPtr, "mox is not initialized or down.");
-    lock_guard locker(*globalMetaDataPtr);
-    auto it = globalMetaDataPtr->metaClassRegister.find(metaType);
-    return it != globalMetaDataPtr->metaClassRegister.cend() ? it->second : nullptr;
+    const auto index = static_cast<size_t>(metaType);
+    if (index >= globalMetaDataPtr->metaTypeTable.size())
+    {
+        return nullptr;
+    }
+    return globalMetaDataPtr->metaTypeTable.get(index)->m_metaClass.load(std::memory_order_acquire);
 }
 
 } // namespace mox
@@ -20,9 +20,51 @@
 #include <property_p.hpp>
 #include <mox/core/meta/property/binding/binding_group.hpp>
 
+#include <functional>
+#include <queue>
+
 namespace mox
 {
 
+namespace
+{
+
+struct ScheduledBinding
+{
+    std::size_t rank = 0u;
+    std::size_t sequence = 0u;
+    BindingSharedPtr binding;
+
+    bool operator>(const ScheduledBinding& other) const
+    {
+        return (rank > other.rank) || ((rank == other.rank) && (sequence > other.sequence));
+    }
+};
+
+/// The change signal of a property updated by a binding.
+struct ChangedSignal
+{
+    PropertyStorage* property = nullptr;
+    Variant value;
+};
+
+/// The bindings scheduled for evaluation on a thread.
+struct PropagationQueue
+{
+    std::priority_queue<ScheduledBinding, std::vector<ScheduledBinding>, std::greater<ScheduledBinding>> bindings;
+    /// The change signals deferred by the evaluations.
+    std::vector<ChangedSignal> changedSignals;
+    /// The bindings evaluated by the running pass.
+    std::vector<BindingSharedPtr> evaluated;
+    /// The binding the running pass is evaluating, \e nullptr if its evaluation got deferred.
+    BindingPrivate* evaluating = nullptr;
+    std::size_t sequence = 0u;
+    bool running = false;
+};
+thread_local PropagationQueue propagation;
+
+} // noname
+
 /******************************************************************************
  * BindingPrivate
  */
@@ -31,6 +73,9 @@ BindingPrivate::BindingPrivate(Binding* pp, bool permanent)
     , enabled(false)
     , evaluateOnEnabled(true)
     , isPermanent(permanent)
+    , isScheduled(false)
+    , isRaisingRank(false)
+    , isLazy(false)
 {
 }
 
@@ -38,9 +83,14 @@ BindingPrivate::~BindingPrivate()
 {
 }
 
-void BindingPrivate::addDependency(Property &dependency)
+bool BindingPrivate::addDependency(Property &dependency)
 {
-    dependencies.insert(&dependency);
+    auto result = dependencies.try_emplace(&dependency, evaluation);
+    if (!result.second)
+    {
+        result.first->second = evaluation;
+    }
+    return result.second;
 }
 
 void BindingPrivate::removeDependency(Property &dependency)
@@ -51,20 +101,224 @@ void BindingPrivate::removeDependency(Property &dependency)
 void BindingPrivate::clearDependencies()
 {
     auto psh = p_func()->shared_from_this();
-    for (auto dep : dependencies)
+    for (auto& dep : dependencies)
     {
-        auto ddep = PropertyStorage::get(*dep);
+        auto ddep = PropertyStorage::get(*dep.first);
         FATAL(ddep, "Property storage for the dependency already wiped!");
         ddep->unsubscribe(psh);
     }
     dependencies.clear();
 }
 
+void BindingPrivate::pruneDependencies()
+{
+    auto psh = BindingSharedPtr();
+    for (auto it = dependencies.begin(); it != dependencies.end();)
+    {
+        if (it->second == evaluation)
+        {
+            ++it;
+            continue;
+        }
+        if (!psh)
+        {
+            psh = p_func()->shared_from_this();
+        }
+        auto ddep = PropertyStorage::get(*it->first);
+        FATAL(ddep, "Property storage for the dependency already wiped!");
+        ddep->unsubscribe(psh);
+        it = dependencies.erase(it);
+    }
+}
+
 void BindingPrivate::invalidate()
 {
     state = BindingState::Invalid;
 }
 
+void BindingPrivate::raiseRank(std::size_t minimumRank)
+{
+    // A binding already raising its rank is part of a binding loop.
+    if (rank >= minimumRank || isRaisingRank)
+    {
+        return;
+    }
+
+    rank = minimumRank;
+    if (target)
+    {
+        auto dTarget = PropertyStorage::get(*target);
+        if (dTarget->getRank() < rank)
+        {
+            isRaisingRank = true;
+            dTarget->setRank(rank);
+            isRaisingRank = false;
+        }
+    }
+}
+
+/******************************************************************************
+ * BindingPropagation
+ */
+void BindingPropagation::schedule(BindingSharedPtr binding)
+{
+    auto d = BindingPrivate::get(*binding);
+    if (d->isScheduled)
+    {
+        return;
+    }
+    d->isScheduled = true;
+    propagation.bindings.push({d->rank, propagation.sequence++, std::move(binding)});
+}
+
+void BindingPropagation::run()
+{
+    if (propagation.running)
+    {
+        return;
+    }
+
+    struct RunGuard
+    {
+        // The change signals deferred by the runs in progress on the thread.
+        const std::size_t firstChangedSignal = propagation.changedSignals.size();
+
+        RunGuard()
+        {
+            propagation.running = true;
+        }
+        ~RunGuard()
+        {
+            // Drop the rest of the scheduled bindings and change signals when an evaluation throws.
+            while (!propagation.bindings.empty())
+            {
+                BindingPrivate::get(*propagation.bindings.top().binding)->isScheduled = false;
+                propagation.bindings.pop();
+            }
+            propagation.changedSignals.resize(firstChangedSignal);
+            propagation.evaluating = nullptr;
+            resetEvaluations();
+            propagation.running = false;
+        }
+        static void resetEvaluations()
+        {
+            for (auto& binding : propagation.evaluated)
+            {
+                BindingPrivate::get(*binding)->passEvaluations = 0u;
+            }
+            propagation.evaluated.clear();
+        }
+    };
+    RunGuard guard;
+
+    while (!propagation.bindings.empty())
+    {
+        auto next = propagation.bindings.top();
+        propagation.bindings.pop();
+
+        auto d = BindingPrivate::get(*next.binding);
+        if (d->rank > next.rank)
+        {
+            // The rank was raised after the binding was scheduled.
+            next.rank = d->rank;
+            propagation.bindings.push(std::move(next));
+            continue;
+        }
+        d->isScheduled = false;
+        if (!d->enabled)
+        {
+            continue;
+        }
+        if (d->isLazy && d->target && PropertyStorage::get(*d->target)->markDirty())
+        {
+            // Evaluated when the target is read.
+            continue;
+        }
+
+        // A binding evaluated more than once in a pass is part of a binding loop. The binding loop
+        // detector counts the earlier evaluations of the pass.
+        const auto loopCount = d->passEvaluations;
+        for (auto i = 0u; i < loopCount; ++i)
+        {
+            d->retain();
+        }
+        auto releaser = [d, loopCount]()
+        {
+            for (auto i = 0u; i < loopCount; ++i)
+            {
+                d->release();
+            }
+        };
+
+        propagation.evaluating = d;
+        try
+        {
+            next.binding->evaluateBinding();
+        }
+        catch (...)
+        {
+            releaser();
+            throw;
+        }
+        releaser();
+
+        // An evaluation deferred to a higher rank is not counted.
+        if (propagation.evaluating == d && !d->passEvaluations++)
+        {
+            propagation.evaluated.push_back(next.binding);
+        }
+        propagation.evaluating = nullptr;
+    }
+    RunGuard::resetEvaluations();
+
+    // Emit the change signals in the order the recursive evaluation of the bindings would. The
+    // slots of the signals may update further properties.
+    propagation.running = false;
+    while (propagation.changedSignals.size() > guard.firstChangedSignal)
+    {
+        auto changed = std::move(propagation.changedSignals.back());
+        propagation.changedSignals.pop_back();
+        if (changed.property)
+        {
+            changed.property->getProperty()->changed.activate(Callable::ArgumentPack(changed.value));
+        }
+    }
+}
+
+bool BindingPropagation::deferEvaluation(BindingPrivate& binding, std::size_t rank)
+{
+    // Only the bindings pending below the new rank can still change the dependencies.
+    if (propagation.evaluating != &binding || propagation.bindings.empty() || propagation.bindings.top().rank >= rank)
+    {
+        return false;
+    }
+    propagation.evaluating = nullptr;
+    binding.rank = rank;
+    schedule(binding.p_func()->shared_from_this());
+    return true;
+}
+
+bool BindingPropagation::deferChangedSignal(PropertyStorage& property, const Variant& value)
+{
+    if (!propagation.running)
+    {
+        return false;
+    }
+    propagation.changedSignals.push_back({&property, value});
+    return true;
+}
+
+void BindingPropagation::cancelChangedSignals(PropertyStorage& property)
+{
+    for (auto& changed : propagation.changedSignals)
+    {
+        if (changed.property == &property)
+        {
+            changed.property = nullptr;
+        }
+    }
+}
+
 /******************************************************************************
  * BindingLoopDetector
  */
@@ -215,13 +469,15 @@ void Binding::evaluateBinding()
         return;
     }
 
-    auto dTarget = PropertyStorage::get(*d->target);
-    Variant data = dTarget->fetchDataUnsafe();
     BindingLoopDetector detector(*d);
 
-    d->clearDependencies();
-    BindingScope setCurrent(*this);
-    evaluate();
+    // Only the dependencies added or dropped by this evaluation change the subscriptions.
+    d->beginDependencyTracking();
+    {
+        BindingScope setCurrent(*this);
+        evaluate();
+    }
+    d->pruneDependencies();
 }
 
 void Binding::updateTarget(Variant &value)
@@ -230,7 +486,28 @@ void Binding::updateTarget(Variant &value)
     {
         return;
     }
-    auto dTarget = PropertyStorage::get(*d_func()->target);
+
+    // Rank the binding above its dependencies, and the target with the binding.
+    D();
+    std::size_t rank = 0u;
+    for (auto& dependency : d->dependencies)
+    {
+        if (dependency.second == d->evaluation)
+        {
+            rank = std::max(rank, PropertyStorage::get(*dependency.first)->getRank());
+        }
+    }
+    auto dTarget = PropertyStorage::get(*d->target);
+    if (rank + 1u > d->rank && BindingPropagation::deferEvaluation(*d, rank + 1u))
+    {
+        // The binding read a dependency ahead of its evaluation in the pass. Drop the value, and
+        // evaluate the binding again with the dependency evaluated.
+        dTarget->setRank(d->rank);
+        return;
+    }
+    d->rank = rank + 1u;
+
+    dTarget->setRank(d->rank);
     dTarget->updateData(value);
 }
 
@@ -295,6 +572,26 @@ void Binding::setEvaluateOnEnabled(bool doEvaluate)
     d_func()->evaluateOnEnabled = doEvaluate;
 }
 
+bool Binding::isLazy() const
+{
+    return d_func()->isLazy;
+}
+
+void Binding::setLazy(bool lazy)
+{
+    D();
+    if (d->isLazy == lazy)
+    {
+        return;
+    }
+    d->isLazy = lazy;
+    if (!lazy && d->target)
+    {
+        // Bring the target up to date.
+        PropertyStorage::get(*d->target)->evaluateDirtyBinding();
+    }
+}
+
 Property* Binding::getTarget() const
 {
     return d_func()->target;
@@ -65,6 +65,7 @@ bool Property::isReadOnly() const
 Variant Property::get() const
 {
     throwIf<ExceptionType::InvalidProperty>(!isValid());
+    const_cast<PropertyStorage*>(d_ptr.get())->evaluateDirtyBinding();
     lock_guard lock(const_cast<Property&>(*this));
     const_cast<PropertyStorage*>(d_ptr.get())->notifyAccessed();
     return d_ptr->fetchDataUnsafe();
@@ -75,13 +76,49 @@ void Property::set(const Variant& value)
     throwIf<ExceptionType::InvalidProperty>(!isValid());
     throwIf<ExceptionType::AttempWriteReadOnlyProperty>(isReadOnly());
 
-    // Detach bindings that are not permanent.
+    // Detach bindings that are not permanent, and drop the pending evaluation of the lazy binding.
     d_ptr->detachNonPermanentBindings();
+    d_ptr->clearDirty();
 
     // Set the value.
     d_ptr->updateData(value);
 }
 
+PropertyDataProvider& Property::getDataProvider() const
+{
+    return d_ptr->getDataProvider();
+}
+
+void Property::notifyAccessed()
+{
+    throwIf<ExceptionType::InvalidProperty>(!isValid());
+    d_ptr->notifyAccessed();
+}
+
+void Property::prepareWrite()
+{
+    throwIf<ExceptionType::InvalidProperty>(!isValid());
+    throwIf<ExceptionType::AttempWriteReadOnlyProperty>(isReadOnly());
+    d_ptr->detachNonPermanentBindings();
+    d_ptr->clearDirty();
+}
+
+bool Property::isUnbound() const
+{
+    return d_ptr->isUnboundUnsafe();
+}
+
+void Property::propagateChanges(const Variant& value)
+{
+    d_ptr->propagateChanges(value);
+}
+
+void Property::evaluateDirtyBinding()
+{
+    throwIf<ExceptionType::InvalidProperty>(!isValid());
+    d_ptr->evaluateDirtyBinding();
+}
+
 void Property::reset()
 {
     throwIf<ExceptionType::InvalidProperty>(!isValid());
@@ -21,9 +21,29 @@
 #include <binding_p.hpp>
 #include <metabase_p.hpp>
 
+#include <algorithm>
+#include <utility>
+
 namespace mox
 {
 
+namespace
+{
+
+/// The update scopes of a thread.
+struct UpdateTransaction
+{
+    /// The properties updated within the scopes.
+    std::vector<PropertyStorage*> properties;
+    /// The properties of the scopes propagating their changes.
+    std::vector<std::vector<PropertyStorage*>*> propagating;
+    /// The number of nested scopes.
+    int depth = 0;
+};
+thread_local UpdateTransaction updateTransaction;
+
+} // noname
+
 /******************************************************************************
  * PropertyStorage
  */
@@ -69,9 +89,31 @@ void PropertyStorage::destroy()
     }
     bindingSubscribers.clear();
 
+    // Remove the property from the update scopes.
+    auto removeFrom = [this](std::vector<PropertyStorage*>& properties)
+    {
+        std::replace(properties.begin(), properties.end(), this, static_cast<PropertyStorage*>(nullptr));
+    };
+    if (hasDeferredChanges)
+    {
+        removeFrom(updateTransaction.properties);
+    }
+    if (propagatingScopes > 0)
+    {
+        for (auto properties : updateTransaction.propagating)
+        {
+            removeFrom(*properties);
+        }
+    }
+
+    BindingPropagation::cancelChangedSignals(*this);
+
     dataProvider.m_property = nullptr;
-    // Destroy the storage of the change signal.
-    SignalStorage::get(p_ptr->changed)->destroy();
+    // Destroy the storage of the change signal. The signal locks the host for that.
+    {
+        ScopeRelock relock(host);
+        SignalStorage::destroy(p_ptr->changed);
+    }
     // Self destroy.
     p_ptr->d_ptr.reset();
 }
@@ -90,30 +132,108 @@ void PropertyStorage::resetToDefault()
 
 void PropertyStorage::notifyAccessed()
 {
-    if (BindingScope::currentBinding && BindingScope::currentBinding->getTarget() != p_ptr)
+    auto binding = BindingScope::currentBinding;
+    if (binding && binding->getTarget() != p_ptr)
     {
-        bindingSubscribers.insert(BindingScope::currentBinding->shared_from_this());
-
-        auto currentBinding = BindingPrivate::get(*BindingScope::currentBinding);
-        currentBinding->addDependency(*p_ptr);
+        // Subscribe the binding on its first access only.
+        if (BindingPrivate::get(*binding)->addDependency(*p_ptr))
+        {
+            bindingSubscribers.insert(binding->shared_from_this());
+        }
     }
 }
 
 void PropertyStorage::notifyChanges()
 {
-    auto copy = SubscriberCollection();
     {
         lock_guard lock(host);
-        copy = bindingSubscribers;
+        if (bindingSubscribers.empty())
+        {
+            return;
+        }
+        for (auto& subscriber : bindingSubscribers)
+        {
+            BindingPropagation::schedule(subscriber);
+        }
     }
-    for (auto subscriber : copy)
+    BindingPropagation::run();
+}
+
+bool PropertyStorage::markDirty()
+{
+    lock_guard lock(host);
+    for (auto& subscriber : bindingSubscribers)
     {
-        if (!subscriber->isEnabled())
+        if (!subscriber->isLazy())
         {
-            continue;
+            return false;
+        }
+    }
+    if (!isDirty.exchange(true))
+    {
+        // The lazy bindings depending on this property become dirty too.
+        for (auto& subscriber : bindingSubscribers)
+        {
+            BindingPropagation::schedule(subscriber);
         }
-        subscriber->evaluateBinding();
     }
+    return true;
+}
+
+void PropertyStorage::evaluateDirtyBinding()
+{
+    if (!isDirty.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    auto binding = BindingSharedPtr();
+    {
+        lock_guard lock(host);
+        if (!isDirty.exchange(false))
+        {
+            return;
+        }
+        binding = getTopBinding();
+    }
+    if (binding)
+    {
+        binding->evaluateBinding();
+    }
+}
+
+void PropertyStorage::setRank(std::size_t newRank)
+{
+    if (newRank <= rank)
+    {
+        rank = newRank;
+        return;
+    }
+
+    rank = newRank;
+    auto subscribers = SubscriberCollection();
+    {
+        lock_guard lock(host);
+        subscribers = bindingSubscribers;
+    }
+    for (auto& subscriber : subscribers)
+    {
+        BindingPrivate::get(*subscriber)->raiseRank(rank + 1u);
+    }
+}
+
+bool PropertyStorage::deferChanges()
+{
+    if (!updateTransaction.depth)
+    {
+        return false;
+    }
+    if (!hasDeferredChanges)
+    {
+        hasDeferredChanges = true;
+        updateTransaction.properties.push_back(this);
+    }
+    return true;
 }
 
 void PropertyStorage::unsubscribe(BindingSharedPtr binding)
@@ -160,6 +280,10 @@ void PropertyStorage::detachNonPermanentBindings()
 {
     // lock as we mangle property data
     lock_guard lock(host);
+    if (bindings.empty())
+    {
+        return;
+    }
     SignalBlocker block(p_ptr->changed);
 
     auto copy = bindings;
@@ -215,16 +339,177 @@ void PropertyStorage::updateData(const Variant& newValue)
 {
     {
         lock_guard lock(host);
-        if (newValue == dataProvider.getData())
+        auto oldValue = dataProvider.getData();
+        if (newValue == oldValue)
         {
             return;
         }
+        if (updateTransaction.depth && !hasDeferredChanges)
+        {
+            // The change signal is emitted on the scope exit only if the value ends up different.
+            scopeStartValue = std::move(oldValue);
+        }
         dataProvider.setData(newValue);
     }
 
+    propagateChanges(newValue);
+}
+
+void PropertyStorage::propagateChanges(const Variant& newValue)
+{
+    if (deferChanges())
+    {
+        return;
+    }
+    // The change supersedes the change signal pending on the update scope exit.
+    hasPendingChangedSignal = false;
+
     notifyChanges();
 
-    p_ptr->changed.activate(Callable::ArgumentPack(newValue));
+    if (!p_ptr->changed.hasConnections())
+    {
+        return;
+    }
+    auto emitChanged = [this](const Variant& value)
+    {
+        if (!BindingPropagation::deferChangedSignal(*this, value))
+        {
+            p_ptr->changed.activate(Callable::ArgumentPack(value));
+        }
+    };
+    if (newValue.isValid())
+    {
+        emitChanged(newValue);
+        return;
+    }
+    Variant value;
+    {
+        lock_guard lock(host);
+        value = fetchDataUnsafe();
+    }
+    emitChanged(value);
+}
+
+/******************************************************************************
+ * PropertyUpdateScope
+ */
+PropertyUpdateScope::PropertyUpdateScope()
+{
+    ++updateTransaction.depth;
+}
+
+PropertyUpdateScope::~PropertyUpdateScope()
+{
+    if (m_closed)
+    {
+        return;
+    }
+    try
+    {
+        commit();
+    }
+    catch (std::exception& e)
+    {
+        CWARN(metacore, "Property update scope failed to propagate the changes: " << e.what());
+    }
+    catch (...)
+    {
+        CWARN(metacore, "Property update scope failed to propagate the changes.");
+    }
+}
+
+void PropertyUpdateScope::commit()
+{
+    if (m_closed)
+    {
+        return;
+    }
+    m_closed = true;
+    if (--updateTransaction.depth > 0)
+    {
+        return;
+    }
+
+    // The properties updated by the bindings and the slots below are no longer deferred.
+    auto updated = std::move(updateTransaction.properties);
+    updateTransaction.properties.clear();
+    updated.erase(std::remove(updated.begin(), updated.end(), nullptr), updated.end());
+
+    // Releases the updated properties also when the propagation throws.
+    struct PropagationGuard
+    {
+        std::vector<PropertyStorage*>& updated;
+
+        explicit PropagationGuard(std::vector<PropertyStorage*>& updated)
+            : updated(updated)
+        {
+            updateTransaction.propagating.push_back(&updated);
+            for (auto property : updated)
+            {
+                property->hasDeferredChanges = false;
+                property->hasPendingChangedSignal = true;
+                ++property->propagatingScopes;
+            }
+        }
+        ~PropagationGuard()
+        {
+            for (auto property : updated)
+            {
+                if (property)
+                {
+                    property->hasPendingChangedSignal = false;
+                    --property->propagatingScopes;
+                }
+            }
+            updateTransaction.propagating.pop_back();
+        }
+    };
+    PropagationGuard guard(updated);
+
+    // Schedule the bindings subscribed to the updated properties, and evaluate them.
+    std::vector<Variant> startValues;
+    startValues.reserve(updated.size());
+    for (auto property : updated)
+    {
+        lock_guard lock(property->host);
+        startValues.push_back(std::exchange(property->scopeStartValue, Variant()));
+        for (auto& subscriber : property->bindingSubscribers)
+        {
+            BindingPropagation::schedule(subscriber);
+        }
+    }
+    BindingPropagation::run();
+
+    // The properties whose change the bindings propagated already, or whose value is restored by
+    // the end of the scope, emit no change signal.
+    for (std::size_t i = 0u; i < updated.size(); ++i)
+    {
+        auto property = updated[i];
+        if (!property || !property->hasPendingChangedSignal)
+        {
+            continue;
+        }
+        property->hasPendingChangedSignal = false;
+        if (!property->p_ptr->changed.hasConnections())
+        {
+            continue;
+        }
+        Variant value;
+        {
+            lock_guard lock(property->host);
+            value = property->fetchDataUnsafe();
+        }
+        if (startValues[i].isValid() && value == startValues[i])
+        {
+            continue;
+        }
+        property->p_ptr->changed.activate(Callable::ArgumentPack(value));
+    }
+}
+
+bool PropertyUpdateScope::isActive()
+{
+    return updateTransaction.depth > 0;
 }
 
 }
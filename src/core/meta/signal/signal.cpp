@@ -24,9 +24,171 @@
 
 #include <mox/core/process/thread_loop.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <optional>
+
 namespace mox
 {
 
+namespace
+{
+
+/// Returns a connection container modifier that erases the connections matching the \a predicate.
+template <typename Predicate>
+auto connectionEraser(Predicate& predicate)
+{
+    return [&predicate](std::vector<Signal::ConnectionSharedPtr>& connections)
+    {
+        auto end = std::remove_if(connections.begin(), connections.end(), predicate);
+        if (end == connections.end())
+        {
+            return false;
+        }
+        connections.erase(end, connections.end());
+        return true;
+    };
+}
+
+/// The signals activated in the current thread. Guards the signals from recursive activation
+/// within the same thread, without blocking activations from other threads.
+thread_local std::vector<const SignalStorage*> threadActiveSignals;
+
+struct ActivationScope
+{
+    explicit ActivationScope(const SignalStorage& signal)
+    {
+        threadActiveSignals.push_back(&signal);
+    }
+    ~ActivationScope()
+    {
+        threadActiveSignals.pop_back();
+    }
+
+    static bool isActive(const SignalStorage& signal)
+    {
+        return std::find(threadActiveSignals.begin(), threadActiveSignals.end(), &signal) != threadActiveSignals.end();
+    }
+
+    DISABLE_COPY(ActivationScope)
+};
+
+/// Marks the workers of the signal dispatch pool.
+thread_local bool isDispatchWorker = false;
+
+/// The state of a parallel activation, shared between the activating thread and the workers.
+struct ParallelActivationState
+{
+    explicit ParallelActivationState(Callable::ArgumentPack&& arguments, const SignalStorage& signal)
+        : arguments(std::move(arguments))
+        , signal(signal)
+    {
+    }
+
+    void fail(std::exception_ptr error)
+    {
+        std::lock_guard<std::mutex> lock(exceptionLock);
+        if (!exception)
+        {
+            exception = error;
+        }
+    }
+
+    /// Completes a range of the activation. The last range completes the join handle.
+    void complete()
+    {
+        if (--pending > 0)
+        {
+            return;
+        }
+        if (exception)
+        {
+            result.set_exception(exception);
+        }
+        else
+        {
+            result.set_value(count);
+        }
+    }
+
+    Callable::ArgumentPack arguments;
+    std::vector<Signal::ConnectionSharedPtr> connections;
+    const SignalStorage& signal;
+    std::promise<int> result;
+    std::exception_ptr exception;
+    std::mutex exceptionLock;
+    std::atomic_int pending = 1;
+    std::atomic_int count = 0;
+};
+
+} // noname
+
+/******************************************************************************
+ * SignalDispatchPool
+ */
+SignalDispatchPool::SignalDispatchPool()
+{
+    const auto workerCount = std::max(1u, std::thread::hardware_concurrency());
+    for (auto i = 0u; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&SignalDispatchPool::work, this);
+    }
+}
+
+SignalDispatchPool::~SignalDispatchPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stopped = true;
+    }
+    m_wakeUp.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+SignalDispatchPool& SignalDispatchPool::get()
+{
+    static SignalDispatchPool pool;
+    return pool;
+}
+
+bool SignalDispatchPool::isWorkerThread()
+{
+    return isDispatchWorker;
+}
+
+void SignalDispatchPool::run(Task&& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_tasks.push_back(std::move(task));
+    }
+    m_wakeUp.notify_one();
+}
+
+void SignalDispatchPool::work()
+{
+    isDispatchWorker = true;
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true)
+    {
+        m_wakeUp.wait(lock, [this]() { return m_stopped || !m_tasks.empty(); });
+        if (m_tasks.empty())
+        {
+            // Stopped, with all the tasks completed.
+            return;
+        }
+        auto task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
 /******************************************************************************
  * SignalType
  */
@@ -50,152 +212,325 @@ const VariantDescriptorContainer& SignalType::getArguments() const
  */
 Signal::Signal(MetaBase& owner, const SignalType& signalType)
     : SharedLock(owner)
-    , d_ptr(pimpl::make_d_ptr<SignalStorage>(*this, owner, signalType))
+    , m_type(signalType)
 {
+    MetaBasePrivate::get(owner)->addSignal(*this);
 }
 
 Signal::~Signal()
 {
-    if (d_ptr)
+    SignalStorage::destroy(*this);
+}
+
+SignalStorage* Signal::ensureStorage()
+{
+    auto d = d_func();
+    if (!d)
     {
-        d_ptr->destroy();
+        d = new SignalStorage(*this);
+        d_ptr.store(d, std::memory_order_release);
     }
+    return d;
 }
 
 bool Signal::isBlocked() const
 {
-    return d_ptr->m_blocked;
+    return m_blocked;
 }
 void Signal::setBlocked(bool blocked)
 {
-    d_ptr->m_blocked = blocked;
+    m_blocked = blocked;
 }
 
 
 void Signal::addConnection(ConnectionSharedPtr connection)
 {
-    FATAL(d_ptr, "Invalid signal");
     lock_guard lock(*this);
-    d_ptr->connections.push_back(connection);
+    ensureStorage()->appendConnection(std::move(connection));
 }
 
 void Signal::removeConnection(ConnectionSharedPtr connection)
 {
-    FATAL(d_ptr, "Invalid signal");
     lock_guard lock(*this);
+    D();
+    if (!d)
+    {
+        return;
+    }
 
-    auto eraser = [&connection](ConnectionSharedPtr conn)
+    auto eraser = [&connection](SignalStorage::ConnectionContainer& connections)
     {
-        if (conn != connection)
+        auto it = std::find(connections.begin(), connections.end(), connection);
+        // A connection claimed by its destroyed receiver is removed by that receiver.
+        if (it == connections.end() || connection->m_signalClaimed)
         {
             return false;
         }
 
         connection->invalidate();
+        connections.erase(it);
         return true;
     };
-    erase_if(d_ptr->connections, eraser);
+    d->updateConnections(eraser);
 }
 
 const SignalType* Signal::getType() const
 {
-    return &d_ptr->getType();
+    return &m_type;
 }
 
-Signal::ConnectionSharedPtr Signal::connect(Callable&& lambda)
+Signal::ConnectionSharedPtr Signal::connect(Callable&& lambda, TypedSlotPtr typedSlot)
 {
-    FATAL(d_ptr, "Invalid signal");
-    return Signal::Connection::create<FunctionConnection>(*this, std::forward<Callable>(lambda));
+    return Signal::Connection::create<FunctionConnection>(*this, std::forward<Callable>(lambda), std::move(typedSlot));
 }
 
-Signal::ConnectionSharedPtr Signal::connect(Variant receiver, Callable&& slot)
+Signal::ConnectionSharedPtr Signal::connect(Variant receiver, Callable&& slot, TypedSlotPtr typedSlot, MetaBase* receiverHost, ConnectionType type)
 {
-    FATAL(d_ptr, "Invalid signal");
-
-    auto connection = ConnectionSharedPtr();
     if (receiver.canConvert<Object*>())
     {
         Object* recv = (Object*)receiver;
-        return Signal::Connection::create<ObjectMethodConnection>(*this, *recv, std::forward<Callable>(slot));
+        return Signal::Connection::create<ObjectMethodConnection>(*this, *recv, std::forward<Callable>(slot), std::move(typedSlot), type);
     }
-    return Signal::Connection::create<MethodConnection>(*this, receiver, std::forward<Callable>(slot));
+    return Signal::Connection::create<MethodConnection>(*this, receiver, receiverHost, std::forward<Callable>(slot), std::move(typedSlot));
 }
 
 Signal::ConnectionSharedPtr Signal::connect(const Signal& signal)
 {
-    FATAL(d_ptr, "Invalid signal");
     // Check if the two arguments match.
-    if (!signal.getType()->isCompatible(d_ptr->getType()))
+    if (!signal.getType()->isCompatible(m_type))
     {
         return nullptr;
     }
 
-    return Signal::Connection::create<SignalConnection>(*this, signal);
+    return Signal::Connection::create<SignalConnection>(*this, signal, signal.m_refCounted);
 }
 
 bool Signal::disconnect(const Signal& signal)
 {
-    FATAL(d_ptr, "Invalid signal");
     lock_guard lock(*this);
+    D();
+    if (!d)
+    {
+        return false;
+    }
 
-    auto predicate = [&signal](ConnectionSharedPtr connection)
+    // The connections to the signal are registered to the host of the signal.
+    auto matches = MetaBasePrivate::get(signal.m_refCounted)->getInboundConnections(*this);
+    auto isOther = [&signal](ConnectionSharedPtr connection)
     {
-        auto signalConnection = std::dynamic_pointer_cast<SignalConnection>(connection);
-        if (signalConnection && signalConnection->receiverSignal() == &signal)
+        if (connection->receiverSignal() == &signal)
         {
             connection->invalidate();
-            return true;
+            return false;
         }
-        return false;
+        return true;
     };
-    return erase_if(d_ptr->connections, predicate);
+    matches.erase(std::remove_if(matches.begin(), matches.end(), isOther), matches.end());
+    return d->removeConnections(matches);
 }
 
-bool Signal::disconnectImpl(Variant receiver, const Callable& callable)
+bool Signal::disconnectImpl(Variant receiver, const Callable& callable, MetaBase* receiverHost)
 {
-    FATAL(d_ptr, "Invalid signal");
     lock_guard lock(*this);
+    D();
+    if (!d)
+    {
+        return false;
+    }
+
+    if (receiverHost)
+    {
+        // Look up the connection among the connections registered to the receiver.
+        auto matches = MetaBasePrivate::get(*receiverHost)->getInboundConnections(*this);
+        auto isOther = [&receiver, &callable](ConnectionSharedPtr connection)
+        {
+            return !connection->disconnect(receiver, callable);
+        };
+        matches.erase(std::remove_if(matches.begin(), matches.end(), isOther), matches.end());
+        return d->removeConnections(matches);
+    }
 
     auto predicate = [&receiver, &callable](ConnectionSharedPtr connection)
     {
-        return (connection && connection->disconnect(receiver, callable));
+        return (connection && !connection->m_signalClaimed && connection->disconnect(receiver, callable));
     };
-    return erase_if(d_ptr->connections, predicate);
+    return d->updateConnections(connectionEraser(predicate));
 }
 
-int Signal::activate(const Callable::ArgumentPack& arguments)
+template <typename Activator>
+int Signal::activateConnections(std::size_t argumentCount, Activator&& activator)
 {
-    FATAL(d_ptr, "Invalid signal");
     D();
-    if (d->triggering || d->m_blocked)
+    if (!d)
+    {
+        // The signal has no connections.
+        return (argumentCount < m_type.getArguments().size()) ? -1 : 0;
+    }
+    if (m_blocked || ActivationScope::isActive(*d))
     {
         return 0;
     }
 
-    lock_guard lock(*this);
-
     // If the signal has more arguments than it had activated with, return -1. Consider it as signal not found.
-    if (arguments.size() < d->type.getArguments().size())
+    if (argumentCount < m_type.getArguments().size())
     {
         return -1;
     }
 
-    FlagScope<true> triggerLock(d->triggering);
+    // The activation works on the snapshot of the connections, without locking the host. Connections
+    // added during activation are not part of the snapshot, and disconnected ones are skipped.
+    auto connections = d->getConnections();
+    if (!connections)
+    {
+        return 0;
+    }
+
+    ActivationScope activationScope(*d);
     int count = 0;
 
-    auto activator = [&arguments, self = this, &count](ConnectionSharedPtr connection)
+    for (auto& connection : *connections)
     {
-        if (!connection)
+        if (!connection->isConnected())
         {
-            return;
+            continue;
         }
-        ScopeRelock relock{*self};
-        connection->activate(arguments);
+        activator(*connection);
         ++count;
-    };
-    for_each(d->connections, activator);
+    }
 
     return count;
 }
 
+int Signal::activate(const Callable::ArgumentPack& arguments)
+{
+    auto activator = [&arguments](Connection& connection)
+    {
+        connection.activate(arguments);
+    };
+    return activateConnections(arguments.size(), activator);
+}
+
+int Signal::activate(const TypedArguments& arguments)
+{
+    // Pack the arguments only once, when the first connection requires packed arguments.
+    std::optional<Callable::ArgumentPack> packedArguments;
+    auto activator = [&arguments, &packedArguments](Connection& connection)
+    {
+        if (connection.activateTyped(arguments))
+        {
+            return;
+        }
+        if (!packedArguments)
+        {
+            packedArguments.emplace(arguments.pack());
+        }
+        connection.activate(*packedArguments);
+    };
+    return activateConnections(arguments.count, activator);
+}
+
+Signal::ParallelActivation Signal::activateParallel(Callable::ArgumentPack arguments)
+{
+    auto readyActivation = [](int count)
+    {
+        std::promise<int> result;
+        result.set_value(count);
+        return result.get_future();
+    };
+
+    D();
+    if (!d || SignalDispatchPool::isWorkerThread())
+    {
+        // No connections, or a nested activation: the workers may be all busy, so activate on
+        // the calling thread.
+        return readyActivation(activate(arguments));
+    }
+    if (m_blocked || ActivationScope::isActive(*d))
+    {
+        return readyActivation(0);
+    }
+    if (arguments.size() < m_type.getArguments().size())
+    {
+        return readyActivation(-1);
+    }
+
+    // The activation works on the snapshot of the connections, the same way activate() does.
+    auto connections = d->getConnections();
+    if (!connections)
+    {
+        return readyActivation(0);
+    }
+
+    // The workers activate the connections that are not bound to a thread. The thread bound
+    // connections are activated on this thread, after the workers are started.
+    auto state = std::make_shared<ParallelActivationState>(std::move(arguments), *d);
+    std::vector<Connection*> threadBound;
+    for (auto& connection : *connections)
+    {
+        if (connection->isThreadBound())
+        {
+            threadBound.push_back(connection.get());
+        }
+        else
+        {
+            state->connections.push_back(connection);
+        }
+    }
+
+    auto activateRange = [](std::shared_ptr<ParallelActivationState> state, std::size_t begin, std::size_t end)
+    {
+        try
+        {
+            ActivationScope activationScope(state->signal);
+            for (auto index = begin; index < end; ++index)
+            {
+                auto& connection = *state->connections[index];
+                if (connection.isConnected())
+                {
+                    connection.activate(state->arguments);
+                    ++state->count;
+                }
+            }
+        }
+        catch (...)
+        {
+            state->fail(std::current_exception());
+        }
+        state->complete();
+    };
+
+    // Split the connections into contiguous ranges, one range per worker.
+    auto activation = state->result.get_future();
+    auto& pool = SignalDispatchPool::get();
+    const auto total = state->connections.size();
+    const auto rangeCount = std::min(total, pool.getWorkerCount());
+    state->pending += static_cast<int>(rangeCount);
+    for (std::size_t range = 0u, begin = 0u; range < rangeCount; ++range)
+    {
+        const auto end = begin + (total - begin) / (rangeCount - range);
+        pool.run([activateRange, state, begin, end]() { activateRange(state, begin, end); });
+        begin = end;
+    }
+
+    try
+    {
+        ActivationScope activationScope(*d);
+        for (auto connection : threadBound)
+        {
+            if (connection->isConnected())
+            {
+                connection->activate(state->arguments);
+                ++state->count;
+            }
+        }
+    }
+    catch (...)
+    {
+        state->fail(std::current_exception());
+    }
+
+    state->complete();
+    return activation;
+}
+
 } // mox
@@ -17,12 +17,15 @@
  */
 
 #include <signal_p.hpp>
+#include <metabase_p.hpp>
 #include <mox/utils/locks.hpp>
 #include <metadata_p.hpp>
 #include <mox/core/object.hpp>
 
 #include <mox/core/process/thread_loop.hpp>
-#include <stack>
+#include <array>
+#include <new>
+#include <vector>
 
 namespace mox
 {
@@ -30,11 +33,54 @@ namespace mox
 namespace
 {
 
-static thread_local std::stack<Signal::ConnectionSharedPtr> threadActiveConnections;
+/// The connections activated on the thread, the innermost one last. The stack keeps the usual
+/// nesting depths inline, and grows on the heap past that.
+class ActiveConnectionStack
+{
+public:
+    static constexpr std::size_t InlineCapacity = 256u;
+
+    void push(Signal::Connection& connection)
+    {
+        if (m_count < InlineCapacity)
+        {
+            m_inline[m_count] = &connection;
+        }
+        else
+        {
+            m_overflow.push_back(&connection);
+        }
+        ++m_count;
+    }
+
+    void pop()
+    {
+        --m_count;
+        if (m_count >= InlineCapacity)
+        {
+            m_overflow.pop_back();
+        }
+    }
+
+    Signal::Connection* top() const
+    {
+        if (!m_count)
+        {
+            return nullptr;
+        }
+        return (m_count <= InlineCapacity) ? m_inline[m_count - 1u] : m_overflow.back();
+    }
+
+private:
+    std::array<Signal::Connection*, InlineCapacity> m_inline;
+    std::vector<Signal::Connection*> m_overflow;
+    std::size_t m_count = 0u;
+};
+thread_local ActiveConnectionStack threadActiveConnections;
 
 struct ConnectionScope
 {
-    explicit ConnectionScope(Signal::ConnectionSharedPtr connection)
+    explicit ConnectionScope(Signal::Connection& connection)
     {
         threadActiveConnections.push(connection);
     }
@@ -43,26 +89,161 @@ struct ConnectionScope
         threadActiveConnections.pop();
     }
 
+    DISABLE_COPY(ConnectionScope)
 };
 
+/// Caches the connection blocks released on a thread by size classes, so connecting slots reuses
+/// the blocks of the disconnected ones.
+class ConnectionBlockCache
+{
+public:
+    static constexpr std::size_t Granularity = 32u;
+    static constexpr std::size_t ClassCount = 16u;
+    static constexpr std::size_t MaxCachedBlocks = 64u;
+
+    ~ConnectionBlockCache();
+
+    void* allocate(std::size_t size)
+    {
+        const auto index = sizeClass(size);
+        if (index >= ClassCount)
+        {
+            return ::operator new(size);
+        }
+        auto block = m_blocks[index];
+        if (!block)
+        {
+            return ::operator new(blockSize(size));
+        }
+        m_blocks[index] = block->next;
+        --m_blockCounts[index];
+        return block;
+    }
+
+    /// Returns the size of the block allocated for \a size bytes. A block released on any thread
+    /// must fit the size class it gets cached in.
+    static std::size_t blockSize(std::size_t size)
+    {
+        const auto index = sizeClass(size);
+        return (index < ClassCount) ? (index + 1u) * Granularity : size;
+    }
+
+    void release(void* block, std::size_t size)
+    {
+        const auto index = sizeClass(size);
+        if (index >= ClassCount || m_blockCounts[index] >= MaxCachedBlocks)
+        {
+            ::operator delete(block);
+            return;
+        }
+        m_blocks[index] = new (block) Block{m_blocks[index]};
+        ++m_blockCounts[index];
+    }
+
+private:
+    struct Block
+    {
+        Block* next;
+    };
+
+    static std::size_t sizeClass(std::size_t size)
+    {
+        return (size - 1u) / Granularity;
+    }
+
+    std::array<Block*, ClassCount> m_blocks = {};
+    std::array<std::size_t, ClassCount> m_blockCounts = {};
+};
+
+thread_local ConnectionBlockCache threadBlockCache;
+// Connections released by the thread local objects destroyed after the cache go to the heap.
+thread_local bool threadBlockCacheDestroyed = false;
+
+ConnectionBlockCache::~ConnectionBlockCache()
+{
+    threadBlockCacheDestroyed = true;
+    for (auto block : m_blocks)
+    {
+        while (block)
+        {
+            auto next = block->next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+}
+
+/// Activates a \a connection on the thread of the \a receiver, and waits for its completion. The
+/// exception thrown by the slot is rethrown to the activating thread.
+template <class ConnectionClass>
+void activateBlocking(ConnectionClass& connection, ObjectSharedPtr receiver, const Callable::ArgumentPack& args)
+{
+    auto self = std::static_pointer_cast<ConnectionClass>(connection.shared_from_this());
+    auto invoker = [self, args]()
+    {
+        self->activate(args);
+    };
+    invokeOn(receiver, invoker).get();
+}
+
 } // noname
 
 /******************************************************************************
  *
  */
-Signal::Connection::Connection(Signal& signal)
+Signal::Connection::Connection(Signal& signal, MetaBase* receiver)
     : m_signal(&signal)
 {
+    if (receiver)
+    {
+        MetaBasePrivate::linkConnection(*receiver, *this);
+    }
+}
+
+Signal::Connection::~Connection()
+{
+    MetaBasePrivate::unlinkConnection(*this);
+}
+
+void* Signal::Connection::allocateBlock(std::size_t size)
+{
+    return threadBlockCacheDestroyed ? ::operator new(ConnectionBlockCache::blockSize(size)) : threadBlockCache.allocate(size);
+}
+
+void Signal::Connection::releaseBlock(void* block, std::size_t size)
+{
+    if (threadBlockCacheDestroyed)
+    {
+        ::operator delete(block);
+        return;
+    }
+    threadBlockCache.release(block, size);
+}
+
+bool Signal::Connection::activateTyped(const TypedArguments&)
+{
+    return false;
 }
 
 void Signal::Connection::invalidate()
 {
     m_signal = nullptr;
+    MetaBasePrivate::unlinkConnection(*this);
+}
+
+Signal* Signal::Connection::receiverSignal() const
+{
+    return nullptr;
+}
+
+bool Signal::Connection::isThreadBound() const
+{
+    return false;
 }
 
 Signal* Signal::Connection::signal() const
 {
-    return m_signal;
+    return m_signal.load();
 }
 
 bool Signal::Connection::disconnect()
@@ -72,24 +253,32 @@ bool Signal::Connection::disconnect()
         return false;
     }
 
-    if (m_signal)
+    auto signal = m_signal.load();
+    if (signal)
     {
-        m_signal->removeConnection(shared_from_this());
+        signal->removeConnection(shared_from_this());
     }
     return true;
 }
 
 Signal::ConnectionSharedPtr Signal::Connection::getActiveConnection()
 {
-    return threadActiveConnections.top();
+    auto connection = threadActiveConnections.top();
+    return connection ? connection->shared_from_this() : nullptr;
 }
 
 /******************************************************************************
  * FunctionConnection
  */
-FunctionConnection::FunctionConnection(Signal& signal, Callable&& callable)
-    : BaseClass(signal)
+FunctionConnection::FunctionConnection(Signal& signal, Callable&& callable, Signal::TypedSlotPtr typedSlot)
+    : FunctionConnection(signal, nullptr, std::forward<Callable>(callable), std::move(typedSlot))
+{
+}
+
+FunctionConnection::FunctionConnection(Signal& signal, MetaBase* receiver, Callable&& callable, Signal::TypedSlotPtr typedSlot)
+    : BaseClass(signal, receiver)
     , m_slot(std::forward<Callable>(callable))
+    , m_typedSlot(std::move(typedSlot))
 {
 }
 
@@ -105,12 +294,26 @@ bool FunctionConnection::disconnect(Variant, const Callable &callable)
 
 void FunctionConnection::activate(const Callable::ArgumentPack& args)
 {
-    ConnectionScope activeConnection(shared_from_this());
+    ConnectionScope activeConnection(*this);
     m_slot.apply(args);
 }
 
+bool FunctionConnection::activateTyped(const Signal::TypedArguments& args)
+{
+    if (!m_typedSlot || !m_typedSlot->isInvocableWith(args))
+    {
+        return false;
+    }
+
+    ConnectionScope activeConnection(*this);
+    m_typedSlot->invoke(args);
+    return true;
+}
+
 void FunctionConnection::invalidate()
 {
+    // The typed slot is kept till the connection is destroyed, as the slot may be the one that
+    // disconnects the connection.
     m_slot.reset();
     Connection::invalidate();
 }
@@ -118,9 +321,10 @@ void FunctionConnection::invalidate()
 /******************************************************************************
  * ObjectMethodConnection
  */
-ObjectMethodConnection::ObjectMethodConnection(Signal& signal, Object& receiver, Callable&& method)
-    : FunctionConnection(signal, std::forward<Callable>(method))
+ObjectMethodConnection::ObjectMethodConnection(Signal& signal, Object& receiver, Callable&& method, Signal::TypedSlotPtr typedSlot, Signal::ConnectionType type)
+    : FunctionConnection(signal, &receiver, std::forward<Callable>(method), std::move(typedSlot))
     , m_receiver(receiver.shared_from_this())
+    , m_type(type)
 {
 }
 
@@ -145,17 +349,45 @@ void ObjectMethodConnection::activate(const Callable::ArgumentPack& args)
     {
         return;
     }
-    if (receiver->threadData() != ThreadData::getThisThreadData())
+    if (!receiver->isInThisThread())
     {
-        // Async!!
-        postEvent<DeferredSignalEvent>(receiver, *this, args);
+        if (m_type == Signal::ConnectionType::BlockingQueued)
+        {
+            activateBlocking(*this, receiver, args);
+            return;
+        }
+        // Async!! Queue the activation into the batch of the receiver's thread.
+        DeferredSignalBatchEvent::post(receiver, *this, args);
         return;
     }
 
-    ConnectionScope activeConnection(shared_from_this());
+    ConnectionScope activeConnection(*this);
     m_slot.apply(Callable::ArgumentPack(receiver.get(), prepareActivation(args)));
 }
 
+bool ObjectMethodConnection::activateTyped(const Signal::TypedArguments& args)
+{
+    if (!m_typedSlot || !m_typedSlot->isInvocableWith(args))
+    {
+        return false;
+    }
+    auto receiver = m_receiver.lock();
+    if (!receiver)
+    {
+        // Consume the activation, same as the untyped activation does.
+        return true;
+    }
+    if (!receiver->isInThisThread())
+    {
+        // Deferred activations require the packed arguments.
+        return false;
+    }
+
+    ConnectionScope activeConnection(*this);
+    m_typedSlot->invoke(args);
+    return true;
+}
+
 void ObjectMethodConnection::invalidate()
 {
     m_receiver.reset();
@@ -165,8 +397,8 @@ void ObjectMethodConnection::invalidate()
 /******************************************************************************
  *
  */
-MethodConnection::MethodConnection(Signal& signal, Variant receiver, Callable&& callable)
-    : FunctionConnection(signal, std::forward<Callable>(callable))
+MethodConnection::MethodConnection(Signal& signal, Variant receiver, MetaBase* receiverHost, Callable&& callable, Signal::TypedSlotPtr typedSlot)
+    : FunctionConnection(signal, receiverHost, std::forward<Callable>(callable), std::move(typedSlot))
     , m_receiver(receiver)
 {
 }
@@ -182,7 +414,7 @@ bool MethodConnection::disconnect(Variant receiver, const Callable& callable)
 
 void MethodConnection::activate(const Callable::ArgumentPack& args)
 {
-    ConnectionScope activeConnection(shared_from_this());
+    ConnectionScope activeConnection(*this);
     m_slot.apply(Callable::ArgumentPack(m_receiver, prepareActivation(args)));
 }
 
@@ -195,10 +427,11 @@ void MethodConnection::invalidate()
 /******************************************************************************
  * ObjectMetaMethodConnection
  */
-ObjectMetaMethodConnection::ObjectMetaMethodConnection(Signal& signal, Object& receiver, const Callable& slot)
-    : BaseClass(signal)
+ObjectMetaMethodConnection::ObjectMetaMethodConnection(Signal& signal, Object& receiver, const Callable& slot, Signal::ConnectionType type)
+    : BaseClass(signal, &receiver)
     , m_receiver(receiver.shared_from_this())
     , m_slot(&slot)
+    , m_type(type)
 {
 }
 
@@ -225,14 +458,19 @@ void ObjectMetaMethodConnection::activate(const Callable::ArgumentPack& args)
         invalidate();
         return;
     }
-    if (receiver->threadData() != ThreadData::getThisThreadData())
+    if (!receiver->isInThisThread())
     {
-        // Async!!
-        postEvent<DeferredSignalEvent>(receiver, *this, args);
+        if (m_type == Signal::ConnectionType::BlockingQueued)
+        {
+            activateBlocking(*this, receiver, args);
+            return;
+        }
+        // Async!! Queue the activation into the batch of the receiver's thread.
+        DeferredSignalBatchEvent::post(receiver, *this, args);
         return;
     }
 
-    ConnectionScope activeConnection(shared_from_this());
+    ConnectionScope activeConnection(*this);
     m_slot->apply(Callable::ArgumentPack(receiver.get(), prepareActivation(args)));
 }
 
@@ -246,9 +484,9 @@ void ObjectMetaMethodConnection::invalidate()
 /******************************************************************************
  * MetaMethodConnection
  */
-MetaMethodConnection::MetaMethodConnection(Signal& signal, Variant receiver, const Callable& slot)
-    : BaseClass(signal)
-    , m_receiver(receiver)
+MetaMethodConnection::MetaMethodConnection(Signal& signal, MetaBase& receiver, const Callable& slot)
+    : BaseClass(signal, &receiver)
+    , m_receiver(&receiver)
     , m_slot(&slot)
 {
 }
@@ -265,7 +503,7 @@ bool MetaMethodConnection::disconnect(Variant receiver, const Callable &callable
 
 void MetaMethodConnection::activate(const Callable::ArgumentPack& args)
 {
-    ConnectionScope activeConnection(shared_from_this());
+    ConnectionScope activeConnection(*this);
     m_slot->apply(Callable::ArgumentPack(m_receiver, prepareActivation(args)));
 }
 
@@ -279,8 +517,8 @@ void MetaMethodConnection::invalidate()
 /******************************************************************************
  *
  */
-SignalConnection::SignalConnection(Signal& sender, const Signal& other)
-    : Signal::Connection(sender)
+SignalConnection::SignalConnection(Signal& sender, const Signal& other, MetaBase& receiverHost)
+    : Signal::Connection(sender, &receiverHost)
     , m_receiverSignal(const_cast<Signal*>(&other))
 {
 }
@@ -298,6 +536,15 @@ void SignalConnection::activate(const Callable::ArgumentPack& args)
     }
 }
 
+bool SignalConnection::activateTyped(const Signal::TypedArguments& args)
+{
+    if (m_receiverSignal)
+    {
+        m_receiverSignal->activate(args);
+    }
+    return true;
+}
+
 void SignalConnection::invalidate()
 {
     m_receiverSignal = nullptr;
@@ -19,26 +19,134 @@
 #include <signal_p.hpp>
 #include <metabase_p.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
 namespace mox
 {
 
-SignalStorage::SignalStorage(Signal& signal, MetaBase& host, const SignalType& type)
-    : host(host)
-    , type(type)
-    , p_ptr(&signal)
+SignalStorage::SignalStorage(Signal& signal)
+    : p_ptr(&signal)
 {
-    MetaBasePrivate::get(host)->addSignal(*this);
 }
 
 SignalStorage::~SignalStorage()
 {
 }
 
-void SignalStorage::destroy()
+SignalStorage::ConnectionSnapshot SignalStorage::getConnections() const
+{
+    std::lock_guard<std::mutex> lock(snapshotLock);
+    connectionsShared = true;
+    return connections;
+}
+
+void SignalStorage::appendConnection(Signal::ConnectionSharedPtr connection)
+{
+    {
+        std::lock_guard<std::mutex> lock(snapshotLock);
+        // Snapshots are only taken under the snapshot lock. A list that was never handed out
+        // has no readers, and can be appended in place.
+        if (!connections || connectionsShared)
+        {
+            auto copy = std::make_shared<ConnectionContainer>();
+            if (connections)
+            {
+                copy->reserve(connections->size() + 1u);
+                copy->insert(copy->end(), connections->begin(), connections->end());
+            }
+            connections = std::move(copy);
+            connectionsShared = false;
+        }
+        connections->push_back(std::move(connection));
+    }
+    p_ptr->m_hasConnections.store(true, std::memory_order_release);
+}
+
+bool SignalStorage::removeConnections(const std::vector<Signal::ConnectionSharedPtr>& matches)
 {
-    for_each(connections, [](Signal::ConnectionSharedPtr connection) { if (connection) connection->m_signal = nullptr; });
-    MetaBasePrivate::get(host)->removeSignal(this);
-    p_ptr->d_ptr.reset();
+    if (matches.empty())
+    {
+        return false;
+    }
+
+    // Look the connections up in a sorted copy, as the matches may be many.
+    std::vector<Signal::Connection*> sorted;
+    sorted.reserve(matches.size());
+    std::transform(matches.begin(), matches.end(), std::back_inserter(sorted), [](auto& match) { return match.get(); });
+    std::sort(sorted.begin(), sorted.end(), std::less<Signal::Connection*>());
+
+    auto isMatch = [&sorted](const Signal::ConnectionSharedPtr& connection)
+    {
+        return std::binary_search(sorted.begin(), sorted.end(), connection.get(), std::less<Signal::Connection*>());
+    };
+    auto eraser = [&isMatch](ConnectionContainer& connections)
+    {
+        auto end = std::remove_if(connections.begin(), connections.end(), isMatch);
+        if (end == connections.end())
+        {
+            return false;
+        }
+        connections.erase(end, connections.end());
+        return true;
+    };
+    return updateConnections(eraser);
+}
+
+void SignalStorage::destroy(Signal& signal)
+{
+    if (signal.m_attached)
+    {
+        // The connections of other signals to this one are registered to the host. Those must not
+        // reach the signal once it is destroyed.
+        MetaBasePrivate::get(signal.m_refCounted)->disconnectSignalConnections(signal);
+    }
+
+    // Receivers destroyed on other threads remove their connections under the host lock. Those
+    // which claimed a connection before the signal reset it still wait for the lock, and the
+    // signal must outlive them. A signal detached from its host does not lock the host, which may
+    // be gone.
+    std::vector<Signal::ConnectionSharedPtr> claimed;
+    {
+        std::unique_lock<Signal> lock(signal, std::defer_lock);
+        if (signal.m_attached)
+        {
+            lock.lock();
+        }
+        signal.m_hasConnections.store(false, std::memory_order_release);
+        auto d = signal.d_ptr.exchange(nullptr, std::memory_order_acq_rel);
+        if (d)
+        {
+            auto snapshot = d->getConnections();
+            if (snapshot)
+            {
+                for (auto& connection : *snapshot)
+                {
+                    if (!connection->m_signal.exchange(nullptr) && connection->m_signalClaimed)
+                    {
+                        claimed.push_back(connection);
+                    }
+                }
+            }
+            delete d;
+        }
+    }
+    for (auto& connection : claimed)
+    {
+        while (connection->m_signalClaimed)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (signal.m_attached)
+    {
+        signal.m_attached = false;
+        MetaBasePrivate::get(signal.m_refCounted)->removeSignal(signal);
+    }
 }
 
 } // mox
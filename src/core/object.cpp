@@ -260,6 +260,20 @@ void Object::dispatchEvent(Event& event)
         event.setHandled(true);
         return;
     }
+    if (event.type() == EventType::DeferredSignalBatch)
+    {
+        DeferredSignalBatchEvent& deferredBatch = static_cast<DeferredSignalBatchEvent&>(event);
+        deferredBatch.activate();
+        event.setHandled(true);
+        return;
+    }
+    if (event.type() == EventType::DeferredInvocation)
+    {
+        DeferredInvocationEvent& invocation = static_cast<DeferredInvocationEvent&>(event);
+        invocation.activate();
+        event.setHandled(true);
+        return;
+    }
 
     // Collect the objects
     EventDispatcher dispatcher(*this);
@@ -85,6 +85,11 @@ ThreadDataSharedPtr ThreadData::getMainThreadData()
     return mainThreadData ? mainThreadData->shared_from_this() : nullptr;
 }
 
+bool ThreadData::isThisThread(const ThreadData* threadData)
+{
+    return ltsThreadData == threadData;
+}
+
 bool ThreadData::isMainThread() const
 {
     return mainThreadData == this;
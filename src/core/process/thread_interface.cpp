@@ -294,6 +294,22 @@ void ThreadInterface::join()
 /******************************************************************************
  *
  */
+DeferredInvocationEvent::Future invokeOn(ObjectSharedPtr target, Callable&& callable, Callable::ArgumentPack&& arguments)
+{
+    FATAL(target, "Cannot invoke on a null target");
+    auto event = make_event<DeferredInvocationEvent>(target, std::move(callable), std::move(arguments));
+    auto future = event->getFuture();
+    if (target->isInThisThread())
+    {
+        event->activate();
+    }
+    else
+    {
+        postEvent(std::move(event));
+    }
+    return future;
+}
+
 bool postEvent(EventPtr event)
 {
     auto target = event->target();
@@ -311,13 +327,18 @@ bool postEvent(EventPtr event)
     {
         return false;
     }
-    lock_guard lock(*thread);
     auto d = ThreadInterfacePrivate::get(*thread);
-    d->threadQueue.push(std::move(event));
+    if (!d->threadQueue.post(std::move(event)))
+    {
+        CTRACE(event, "Event posted, runloop wakeup already pending");
+        return true;
+    }
 
+    lock_guard lock(*thread);
     if (!d->runLoop)
     {
         CTRACE(event, "RunLoop not specified yet.");
+        d->threadQueue.cancelWakeUp();
         return false;
     }
     CTRACE(event, "Event posted, wake up runloop");
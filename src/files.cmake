@@ -27,8 +27,10 @@ set(HEADERS
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/mox/core/platforms/adaptation.hpp
 
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/mox/utils/containers/shared_vector.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/mox/utils/containers/shared_buffer.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/mox/utils/containers/flat_set.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/mox/utils/containers/flat_map.hpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/../include/mox/utils/containers/mpsc_queue.hpp
 
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/mox/utils/algorithm.hpp
     ${CMAKE_CURRENT_SOURCE_DIR}/../include/mox/utils/ref_counted.hpp
@@ -26,11 +26,13 @@
 #include <mox/config/pimpl.hpp>
 #include <mox/utils/ref_counted.hpp>
 
-#include <unordered_set>
+#include <unordered_map>
 
 namespace mox
 {
 
+class PropertyStorage;
+
 class BindingPrivate : public RefCounted<size_t>
 {
 public:
@@ -41,9 +43,18 @@ public:
     explicit BindingPrivate(Binding* pp, bool permanent);
     ~BindingPrivate();
 
-    void addDependency(Property& dependency);
+    /// Records the access of a \a dependency in the current evaluation of the binding.
+    /// \return If the binding did not depend on the property, \e true, otherwise \e false.
+    bool addDependency(Property& dependency);
     void removeDependency(Property& dependency);
     void clearDependencies();
+    /// Starts recording the dependencies of a new evaluation.
+    inline void beginDependencyTracking()
+    {
+        ++evaluation;
+    }
+    /// Unsubscribes the binding from the dependencies the last evaluation did not access.
+    void pruneDependencies();
     void invalidate();
 
     inline void setGroup(BindingGroupSharedPtr grp)
@@ -54,20 +65,61 @@ public:
     {
         this->enabled = enabled;
     }
+    inline std::size_t getRank() const
+    {
+        return rank;
+    }
+    /// Raises the rank of the binding to \a minimumRank, and the ranks of the bindings depending
+    /// on its target.
+    void raiseRank(std::size_t minimumRank);
 
 protected:
-    using Collection = std::unordered_set<Property*>;
+    /// The dependencies, with the evaluation that last accessed them.
+    using Collection = std::unordered_map<Property*, std::size_t>;
 
     Collection dependencies;
+    /// The number of evaluations of the binding.
+    std::size_t evaluation = 0u;
+    /// The number of evaluations of the binding in the running propagation pass.
+    std::size_t passEvaluations = 0u;
     Binding* p_ptr = nullptr;
     BindingGroupSharedPtr group;
     Property* target = nullptr;
+    /// The topological rank of the binding. The rank of a binding is higher than the rank of the
+    /// bindings of its dependencies.
+    std::size_t rank = 1u;
     BindingState state = BindingState::Detached;
     bool enabled:1;
     bool evaluateOnEnabled:1;
     bool isPermanent:1;
+    bool isScheduled:1;
+    bool isRaisingRank:1;
+    bool isLazy:1;
 
     friend class BindingLoopDetector;
+    friend class BindingPropagation;
+};
+
+/// Propagates the property changes to the bindings of the thread in the order of their ranks.
+/// A binding is evaluated after the bindings of its dependencies, once per change.
+class BindingPropagation
+{
+public:
+    /// Schedules the evaluation of a \a binding. A binding is scheduled only once.
+    static void schedule(BindingSharedPtr binding);
+    /// Evaluates the scheduled bindings. Returns immediately if the thread is already evaluating
+    /// the scheduled bindings. The change signals of the properties updated by the bindings are
+    /// emitted after the evaluations, starting with the last updated property.
+    static void run();
+    /// Defers the evaluation of a \a binding the running pass is evaluating to a higher \a rank,
+    /// when the bindings pending below the rank may still change its dependencies.
+    /// \return If the evaluation got deferred, \e true, otherwise \e false.
+    static bool deferEvaluation(BindingPrivate& binding, std::size_t rank);
+    /// Defers the change signal of a \a property to the end of the evaluations.
+    /// \return If the thread is evaluating the scheduled bindings, \e true, otherwise \e false.
+    static bool deferChangedSignal(PropertyStorage& property, const Variant& value);
+    /// Cancels the deferred change signals of a \a property.
+    static void cancelChangedSignals(PropertyStorage& property);
 };
 
 class PropertyBindingPrivate : public BindingPrivate
@@ -20,24 +20,40 @@
 #define METABASE_P_HPP
 
 #include <mox/core/meta/base/metabase.hpp>
+#include <mox/core/meta/signal/signal.hpp>
 #include <property_p.hpp>
 
+#include <mutex>
+#include <vector>
+
 namespace mox
 {
 
-class SignalStorage;
+class Signal;
 
 class MetaBasePrivate
 {
     using PropertyCollection = std::map<const PropertyType*, PropertyStorage*>;
-    using SignalCollection = std::map<const SignalType*, SignalStorage*>;
     using DynamicPropertyContainer = std::vector<DynamicPropertyPtr>;
 
-    SignalCollection signals;
+    // The signals of the host, linked through the signals.
+    Signal* signals = nullptr;
+    // The connections to the slots of the host, linked through the connections. The registry lock
+    // is a leaf lock, no other lock is taken while holding it.
+    Signal::Connection* inboundConnections = nullptr;
+    mutable std::mutex inboundLock;
     PropertyCollection properties;
     DynamicPropertyContainer dynamicProperties;
 
     void invalidateDynamicProperties();
+    // Removes a connection from the registry. The caller must hold the registry lock.
+    void removeInboundConnection(Signal::Connection& connection);
+    // Removes the connections that match the predicate from the registry, and returns them. The
+    // connections being destroyed are removed only if takeDestroyed is set.
+    template <typename Predicate>
+    std::vector<Signal::ConnectionSharedPtr> takeInboundConnections(Predicate predicate, bool takeDestroyed);
+    // Removes the taken connections from their signals, with one update per signal.
+    static void removeFromSignals(std::vector<Signal::ConnectionSharedPtr>& connections);
 
 public:
     DECLARE_PUBLIC_PTR(MetaBase)
@@ -47,8 +63,20 @@ public:
     {
     }
 
-    void addSignal(SignalStorage& storage);
-    void removeSignal(SignalStorage* storage);
+    void addSignal(Signal& signal);
+    void removeSignal(Signal& signal);
+    Signal* findSignal(const SignalType& type) const;
+
+    /// Registers a \a connection to the slots of a \a receiver.
+    static void linkConnection(MetaBase& receiver, Signal::Connection& connection);
+    /// Removes a \a connection from the registry of its receiver.
+    static void unlinkConnection(Signal::Connection& connection);
+    /// Returns the connections of a \a sender signal to the slots of the host.
+    std::vector<Signal::ConnectionSharedPtr> getInboundConnections(const Signal& sender) const;
+    /// Disconnects the connections to the slots of the host from their signals.
+    void disconnectInboundConnections();
+    /// Disconnects the connections to a \a receiverSignal of the host from their signals.
+    void disconnectSignalConnections(const Signal& receiverSignal);
 
     void addProperty(PropertyStorage& storage);
     void addDynamicProperty(DynamicPropertyPtr property);
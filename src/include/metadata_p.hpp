@@ -21,7 +21,11 @@
 
 #include <vector>
 #include <string>
+#include <array>
+#include <atomic>
 #include <functional>
+#include <typeindex>
+#include <unordered_map>
 #include <mox/config/deftypes.hpp>
 #include <mox/utils/containers/flat_map.hpp>
 #include <mox/core/meta/core/variant.hpp>
@@ -52,22 +56,88 @@ struct MetaData
 
     static const MetatypeDescriptor& addMetaType(const char* name, const std::type_info& rtti, bool isEnum, bool isClass, bool isPointer);
     static MetatypeDescriptor& getMetaType(Metatype type);
+    /// Adds a metatype. The caller must hold the metadata lock.
+    const MetatypeDescriptor& appendMetaType(const char* name, const std::type_info& rtti, bool isEnum, bool isClass, bool isPointer);
+    /// Finds the metatype registered for the \a rtti. The caller must hold the metadata lock.
+    MetatypeDescriptor* findMetaType(const std::type_info& rtti);
 
     static void addMetaClass(const metainfo::MetaClass& metaClass);
     static void removeMetaClass(const metainfo::MetaClass& metaClass);
     static const metainfo::MetaClass* findMetaClass(std::string_view name);
     static const metainfo::MetaClass* getMetaClass(Metatype metaType);
+    /// Registers the names of the pending metaclasses. The caller must hold the metadata lock.
+    void registerPendingMetaClasses();
+
+    static const MetatypeDescriptor::Converter* findConverter(Metatype fromType, Metatype toType);
+    static void invalidateConverters();
+
+    /// Immutable dense converter table, indexed by the source and the destination metatypes. Each
+    /// source type has a row spanning up to the highest destination type it converts to.
+    struct ConverterTable
+    {
+        std::vector<std::pair<size_t, size_t>> rows;
+        std::vector<const MetatypeDescriptor::Converter*> cells;
+
+        const MetatypeDescriptor::Converter* find(Metatype fromType, Metatype toType) const
+        {
+            const auto from = static_cast<size_t>(fromType);
+            const auto to = static_cast<size_t>(toType);
+            if (from >= rows.size() || to >= rows[from].second)
+            {
+                return nullptr;
+            }
+            return cells[rows[from].first + to];
+        }
+    };
+    void rebuildConverterTable();
+
+    /// Append-only table of the metatype descriptors, indexed by the metatype identifier. The table
+    /// grows in fixed size chunks that are never moved, so readers access it without locking.
+    /// Appending to the table requires the metadata lock.
+    class MetatypeTable
+    {
+    public:
+        static constexpr size_t ChunkSize = 256u;
+        static constexpr size_t MaxChunks = 1024u;
+
+        ~MetatypeTable();
+
+        size_t size() const
+        {
+            return m_size.load(std::memory_order_acquire);
+        }
+        MetatypeDescriptor* get(size_t index) const
+        {
+            auto chunk = m_chunks[index / ChunkSize].load(std::memory_order_acquire);
+            return (*chunk)[index % ChunkSize].load(std::memory_order_acquire);
+        }
+        void append(MetatypeDescriptor* descriptor);
+
+    private:
+        using Chunk = std::array<std::atomic<MetatypeDescriptor*>, ChunkSize>;
+        std::array<std::atomic<Chunk*>, MaxChunks> m_chunks = {};
+        std::atomic_size_t m_size = 0u;
+    };
 
     typedef std::vector<std::unique_ptr<MetatypeDescriptor>> MetaTypeContainer;
-    typedef std::vector<std::pair<const std::type_info*, Metatype>> SynonymContainer;
-    typedef FlatMap<Metatype, const metainfo::MetaClass*> MetaClassTypeRegister;
+    typedef std::unordered_map<std::type_index, Metatype> MetaTypeIndex;
     typedef FlatMap<std::string, const metainfo::MetaClass*> MetaClassContainer;
 
     std::mutex selfLock;
     MetaTypeContainer metaTypes;
-    SynonymContainer synonymTypes;
-    MetaClassTypeRegister metaClassRegister;
+    // The descriptors of the metaTypes, read without locking.
+    MetatypeTable metaTypeTable;
+    // The metatypes of the registered RTTIs and their synonyms.
+    MetaTypeIndex metaTypeIndex;
     MetaClassContainer metaClasses;
+    // The metaclasses whose names are not yet registered, linked through the metaclasses. The names
+    // are registered on the next metaclass lookup by name, so metaclasses are added without locking.
+    std::atomic<const metainfo::MetaClass*> pendingMetaClasses = nullptr;
+    // The converter table in use, read without locking. The table is dropped when a converter is
+    // registered, and rebuilt on the next lookup. The superseded tables are kept alive with the
+    // metadata, as converter registrations are rare; the last one in the container is in use.
+    std::atomic<const ConverterTable*> converterTable = nullptr;
+    std::vector<std::unique_ptr<ConverterTable>> converterTables;
     bool initialized = false;
 
     static inline MetaData* globalMetaDataPtr = nullptr;
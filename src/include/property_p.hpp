@@ -22,6 +22,7 @@
 #include <mox/core/meta/property/property.hpp>
 #include <mox/config/pimpl.hpp>
 
+#include <atomic>
 #include <unordered_set>
 
 namespace mox
@@ -50,6 +51,10 @@ public:
     {
         return p_ptr;
     }
+    inline PropertyDataProvider& getDataProvider() const
+    {
+        return dataProvider;
+    }
     BindingSharedPtr getTopBinding();
 
     /// Thread-safe functions.
@@ -73,9 +78,46 @@ public:
     /// Informs the property being accessed.
     void notifyAccessed();
     Variant fetchDataUnsafe() const;
+    /// Tests whether the property has no bindings, and no subscribers.
+    bool isUnboundUnsafe() const
+    {
+        return bindings.empty() && bindingSubscribers.empty();
+    }
     /// Non thread-safe functions.
     void resetToDefault();
 
+    /// Notifies the subscribers about the property value change.
+    void notifyChanges();
+    /// Propagates the change of the property value to the subscribers and to the change signal,
+    /// or defers it to the exit of the update scope. An invalid \a newValue is replaced with the
+    /// property value when the change signal is emitted.
+    void propagateChanges(const Variant& newValue);
+    /// Returns the topological rank of the property, the rank of the binding that last updated it.
+    inline std::size_t getRank() const
+    {
+        return rank;
+    }
+    /// Sets the rank of the property. Raises the ranks of the bindings subscribed to the property
+    /// if the rank is increased.
+    void setRank(std::size_t rank);
+
+    /// Marks the property dirty on behalf of its lazy binding, and schedules the bindings subscribed
+    /// to the property. The caller must not hold the host lock.
+    /// \return If the evaluation of the lazy binding can be deferred, \e true. If a binding that
+    /// is not lazy depends on the property, \e false.
+    bool markDirty();
+    /// Evaluates the lazy binding of a dirty property.
+    void evaluateDirtyBinding();
+    /// Drops the pending evaluation of the lazy binding, superseded by a written value.
+    void clearDirty()
+    {
+        isDirty.store(false, std::memory_order_release);
+    }
+
+    /// Defers the change notifications to the exit of the update scope of the thread.
+    /// \return If the thread has an active update scope, \e true, otherwise \e false.
+    bool deferChanges();
+
 protected:
     using SubscriberCollection = std::unordered_set<BindingSharedPtr>;
     using BindingCollection = std::vector<BindingSharedPtr>;
@@ -89,12 +131,24 @@ protected:
     const PropertyType& type;
     MetaBase& host;
     PropertyDataProvider& dataProvider;
+    /// The topological rank of the property.
+    std::size_t rank = 0u;
+    /// The lazy binding of the property has pending evaluations.
+    std::atomic_bool isDirty = false;
+    /// The number of update scopes propagating the changes of the property.
+    int propagatingScopes = 0;
+    /// The property is waiting for the update scope to exit.
+    bool hasDeferredChanges = false;
+    /// The exit of the update scope is to emit the change signal of the property. Cleared when the
+    /// change propagates earlier, so the signal is emitted once per change.
+    bool hasPendingChangedSignal = false;
+    /// The value of the property before its first update in the update scope.
+    Variant scopeStartValue;
+
+    friend class PropertyUpdateScope;
 
     /// Clears the bindings.
     void clearBindings();
-
-    /// Notifies the subscribers about the property value change.
-    void notifyChanges();
 };
 
 }
@@ -22,6 +22,15 @@
 #include <mox/core/meta/signal/signal.hpp>
 #include <mox/core/meta/signal/signal_type.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace mox
 {
 
@@ -35,34 +44,113 @@ class SignalStorage
 public:
     DECLARE_PUBLIC(Signal, SignalStorage)
 
-    explicit SignalStorage(Signal& signal, MetaBase& host, const SignalType& type);
+    explicit SignalStorage(Signal& signal);
     ~SignalStorage();
 
-    void destroy();
+    /// Destroys the storage of a \a signal, and detaches the signal from its host. The signal
+    /// detached from its host no longer accesses the host on destruction.
+    static void destroy(Signal& signal);
 
     inline const SignalType& getType() const
     {
-        return type;
+        return p_ptr->m_type;
     }
     inline Signal* getSignal() const
     {
         return p_ptr;
     }
 
+    /// Removes the \a matches from the connections of the signal. The caller must hold the host
+    /// lock.
+    /// \return If any of the matches was removed, \e true, otherwise \e false.
+    bool removeConnections(const std::vector<Signal::ConnectionSharedPtr>& matches);
+
 protected:
-    /// The collection of active connections.
-    using ConnectionContainer = SharedVector<Signal::ConnectionSharedPtr>;
-    ConnectionContainer connections;
-    /// The signal owner.
-    MetaBase& host;
-    /// The signal type.
-    const SignalType& type;
+    /// The connection list type.
+    using ConnectionContainer = std::vector<Signal::ConnectionSharedPtr>;
+    /// The immutable snapshot of the connection list.
+    using ConnectionSnapshot = std::shared_ptr<const ConnectionContainer>;
+
+    /// Returns the current snapshot of the connections. The snapshot is not affected by the
+    /// connections added or removed after the call.
+    ConnectionSnapshot getConnections() const;
+
+    /// Replaces the connections with a copy modified by the \a modifier. The modifier returns
+    /// \e true if the copy was modified. The caller must hold the host lock.
+    /// \return The result of the modifier.
+    template <typename Modifier>
+    bool updateConnections(Modifier modifier);
+
+    /// Appends a \a connection to the connections. The connection list is only copied when it was
+    /// handed out as a snapshot since it got published. The caller must hold the host lock.
+    void appendConnection(Signal::ConnectionSharedPtr connection);
+
+    /// The collection of active connections. Activation takes a reference to it under the snapshot
+    /// lock, the modifiers publish a new snapshot.
+    std::shared_ptr<ConnectionContainer> connections;
+    /// Guards the connections pointer only, not the connection list.
+    mutable std::mutex snapshotLock;
+    /// The connection list was handed out as a snapshot, and must not be modified in place.
+    mutable bool connectionsShared = false;
     /// The signal object.
     Signal* p_ptr = nullptr;
-    /// Triggering flag. Locks the signal from recursive triggering.
-    bool triggering = false;
-    /// The signal activation is blocked.
-    bool m_blocked = false;
+};
+
+template <typename Modifier>
+bool SignalStorage::updateConnections(Modifier modifier)
+{
+    auto current = getConnections();
+    auto modified = current ? std::make_shared<ConnectionContainer>(*current) : std::make_shared<ConnectionContainer>();
+    if (!modifier(*modified))
+    {
+        return false;
+    }
+    const bool hasConnections = !modified->empty();
+    {
+        std::lock_guard<std::mutex> lock(snapshotLock);
+        connections = std::move(modified);
+        connectionsShared = false;
+    }
+    p_ptr->m_hasConnections.store(hasConnections, std::memory_order_release);
+    return true;
+}
+
+/******************************************************************************
+ * SignalDispatchPool
+ */
+/// The worker threads of the parallel signal activations. The workers are started on the first
+/// parallel activation, and are joined on exit.
+class SignalDispatchPool
+{
+public:
+    using Task = std::function<void()>;
+
+    ~SignalDispatchPool();
+
+    /// Returns the pool of the process.
+    static SignalDispatchPool& get();
+
+    /// Tests whether the calling thread is a worker of the pool.
+    static bool isWorkerThread();
+
+    /// Returns the number of workers.
+    std::size_t getWorkerCount() const
+    {
+        return m_workers.size();
+    }
+
+    /// Queues a \a task to the workers.
+    void run(Task&& task);
+
+private:
+    SignalDispatchPool();
+    void work();
+
+    std::vector<std::thread> m_workers;
+    std::deque<Task> m_tasks;
+    std::mutex m_lock;
+    std::condition_variable m_wakeUp;
+    bool m_stopped = false;
 };
 
 /******************************************************************************
@@ -77,8 +165,8 @@ class ConnectionPrivates : public Signal::Connection
     }
 
 public:
-    explicit ConnectionPrivates(Signal& signal)
-        : Signal::Connection(signal)
+    explicit ConnectionPrivates(Signal& signal, MetaBase* receiver = nullptr)
+        : Signal::Connection(signal, receiver)
     {
     }
 
@@ -95,9 +183,12 @@ class FunctionConnection : public ConnectionPrivates<FunctionConnection>
 
 protected:
     Callable m_slot;
+    Signal::TypedSlotPtr m_typedSlot;
+
+    FunctionConnection(Signal& signal, MetaBase* receiver, Callable&& callable, Signal::TypedSlotPtr typedSlot);
 
 public:
-    FunctionConnection(Signal& signal, Callable&& callable);
+    FunctionConnection(Signal& signal, Callable&& callable, Signal::TypedSlotPtr typedSlot = nullptr);
 
     bool disconnect(Variant receiver, const Callable& callable) override;
     bool isConnected() const override
@@ -106,6 +197,7 @@ public:
     }
 
     void activate(const Callable::ArgumentPack& args) override;
+    bool activateTyped(const Signal::TypedArguments& args) override;
     void invalidate() override;
 };
 
@@ -116,6 +208,7 @@ class ObjectMetaMethodConnection : public ConnectionPrivates<ObjectMetaMethodCon
 
     ObjectWeakPtr m_receiver;
     const Callable* m_slot;
+    Signal::ConnectionType m_type;
 
 public:
     const Callable* method() const
@@ -123,13 +216,17 @@ public:
         return m_slot;
     }
 
-    ObjectMetaMethodConnection(Signal& signal, Object& receiver, const Callable& slot);
+    ObjectMetaMethodConnection(Signal& signal, Object& receiver, const Callable& slot, Signal::ConnectionType type = Signal::ConnectionType::Auto);
 
     bool isConnected() const override
     {
         return m_slot && (m_slot->type() != FunctionType::Invalid);
     }
     bool disconnect(Variant receiver, const Callable& callable) override;
+    bool isThreadBound() const override
+    {
+        return true;
+    }
     void activate(const Callable::ArgumentPack& args) override;
     void invalidate() override;
 };
@@ -148,7 +245,7 @@ public:
         return m_slot;
     }
 
-    MetaMethodConnection(Signal& signal, Variant receiver, const Callable& slot);
+    MetaMethodConnection(Signal& signal, MetaBase& receiver, const Callable& slot);
 
     bool isConnected() const override
     {
@@ -162,11 +259,18 @@ public:
 class ObjectMethodConnection : public FunctionConnection
 {
     ObjectWeakPtr m_receiver;
+    Signal::ConnectionType m_type;
+
 public:
-    ObjectMethodConnection(Signal& signal, Object& receiver, Callable&& method);
+    ObjectMethodConnection(Signal& signal, Object& receiver, Callable&& method, Signal::TypedSlotPtr typedSlot = nullptr, Signal::ConnectionType type = Signal::ConnectionType::Auto);
 
     bool disconnect(Variant receiver, const Callable& callable) override;
+    bool isThreadBound() const override
+    {
+        return true;
+    }
     void activate(const Callable::ArgumentPack& args) override;
+    bool activateTyped(const Signal::TypedArguments& args) override;
     void invalidate() override;
 };
 
@@ -175,7 +279,7 @@ class MethodConnection : public FunctionConnection
     Variant m_receiver;
 
 public:
-    MethodConnection(Signal& signal, Variant receiver, Callable&& callable);
+    MethodConnection(Signal& signal, Variant receiver, MetaBase* receiverHost, Callable&& callable, Signal::TypedSlotPtr typedSlot = nullptr);
 
     bool disconnect(Variant receiver, const Callable& callable) override;
     void activate(const Callable::ArgumentPack& args) override;
@@ -188,19 +292,25 @@ class SignalConnection : public Signal::Connection
 
 public:
 
-    Signal* receiverSignal() const
+    Signal* receiverSignal() const override
     {
         return m_receiverSignal;
     }
 
-    SignalConnection(Signal& sender, const Signal& other);
+    SignalConnection(Signal& sender, const Signal& other, MetaBase& receiverHost);
 
     bool isConnected() const override
     {
-        return m_receiverSignal && (m_receiverSignal->getType() != nullptr);
+        // The receiver signal resets the connection on destruction.
+        return m_receiverSignal != nullptr;
+    }
+    bool isThreadBound() const override
+    {
+        return true;
     }
     bool disconnect(Variant receiver, const Callable& callable) override;
     void activate(const Callable::ArgumentPack& args) override;
+    bool activateTyped(const Signal::TypedArguments& args) override;
     void invalidate() override;
 };
 
@@ -29,6 +29,10 @@
 #include <mox/config/error.hpp>
 #include <mox/utils/log/logger.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <string>
+
 class UnitTest : public ::testing::Test
 {
 #if defined(MOX_ENABLE_LOGS)
@@ -88,6 +92,34 @@ protected:
     void TearDown() override;
 };
 
+/// Times the benchmarks, and records their results as the properties of the running test. The
+/// benchmarks are the disabled tests named DISABLED_benchmark_*, run them apart from the unit tests
+/// with --gtest_also_run_disabled_tests --gtest_filter=*.DISABLED_benchmark_*
+struct Benchmark
+{
+    /// Runs a \a function, and returns its wall-clock duration in microseconds.
+    template <typename Function>
+    static int64_t measure(Function&& function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /// Records a \a duration in microseconds as the \a name property.
+    static void recordDuration(const std::string& name, int64_t duration)
+    {
+        ::testing::Test::RecordProperty(name, std::to_string(duration));
+    }
+
+    /// Records the \a count operations completed in \a duration microseconds as the \a name
+    /// property, in operations per millisecond.
+    static void recordRate(const std::string& name, int64_t count, int64_t duration)
+    {
+        ::testing::Test::RecordProperty(name, std::to_string(count * 1000 / std::max<int64_t>(1, duration)));
+    }
+};
+
 template <typename T>
 class UpdatingPropertyData : public mox::PropertyData<T>
 {
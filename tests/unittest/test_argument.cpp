@@ -19,6 +19,8 @@
 #include "test_framework.h"
 
 #include <mox/core/meta/core/variant.hpp>
+#include <mox/core/meta/core/callable.hpp>
+#include <mox/utils/containers/shared_buffer.hpp>
 #include <mox/utils/function_traits.hpp>
 
 TEST(Variant, test_argument_init)
@@ -190,3 +192,80 @@ TEST(Variant, test_convert_pointer_to_intptr)
     intptr_t iptr = var;
     EXPECT_EQ(iptr, ipvalue);
 }
+
+TEST(Variant, test_copy_and_move)
+{
+    mox::Variant small(10);
+    mox::Variant large(std::string("a string value that does not fit in place"));
+
+    mox::Variant smallCopy(small);
+    mox::Variant largeCopy(large);
+    EXPECT_TRUE(small == smallCopy);
+    EXPECT_TRUE(large == largeCopy);
+    EXPECT_EQ(10, smallCopy);
+    EXPECT_EQ(std::string("a string value that does not fit in place"), largeCopy);
+
+    mox::Variant moved(std::move(largeCopy));
+    EXPECT_FALSE(largeCopy.isValid());
+    EXPECT_EQ(mox::Metatype::String, moved.metaType());
+    EXPECT_TRUE(large == moved);
+
+    moved = small;
+    EXPECT_EQ(mox::Metatype::Int32, moved.metaType());
+    EXPECT_EQ(10, moved);
+    EXPECT_FALSE(large == moved);
+
+    moved.reset();
+    EXPECT_FALSE(moved.isValid());
+}
+
+TEST(Variant, test_swap_inline_and_shared_values)
+{
+    mox::Variant small(3.5);
+    mox::Variant large(std::string("shared"));
+    mox::Variant invalid;
+
+    small.swap(large);
+    EXPECT_EQ(mox::Metatype::String, small.metaType());
+    EXPECT_EQ(std::string("shared"), small);
+    EXPECT_EQ(mox::Metatype::Double, large.metaType());
+    EXPECT_EQ(3.5, large);
+
+    std::swap(small, invalid);
+    EXPECT_FALSE(small.isValid());
+    EXPECT_EQ(std::string("shared"), invalid);
+}
+
+TEST(Variant, test_converted_value_from_inline_storage)
+{
+    mox::Variant v(101);
+    std::string text = v;
+    EXPECT_EQ("101", text);
+    double real = v;
+    EXPECT_EQ(101.0, real);
+}
+
+TEST(Variant, test_shared_buffer_is_not_copied)
+{
+    std::vector<int32_t> samples(16384u, 7);
+    const int32_t* data = samples.data();
+    mox::Int32Buffer buffer(std::move(samples));
+    EXPECT_EQ(data, buffer.data());
+
+    mox::Variant variant(buffer);
+    EXPECT_EQ(mox::Metatype::Int32Buffer, variant.metaType());
+    mox::Variant copy(variant);
+    mox::Int32Buffer result = copy;
+    EXPECT_EQ(data, result.data());
+
+    mox::Callable::ArgumentPack pack(buffer);
+    mox::Callable::ArgumentPack packCopy(pack);
+    EXPECT_EQ(data, packCopy.get<mox::Int32Buffer>(0).data());
+
+    // Conversion to vector copies the data.
+    std::vector<int32_t> vector = variant;
+    EXPECT_EQ(buffer.get(), vector);
+    EXPECT_NE(data, vector.data());
+    mox::Int32Buffer fromVector = mox::Variant(vector);
+    EXPECT_TRUE(fromVector == buffer);
+}
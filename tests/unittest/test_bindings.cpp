@@ -24,6 +24,9 @@
 #include <mox/core/meta/property/binding/expression_binding.hpp>
 #include <mox/core/object.hpp>
 
+#include <memory>
+#include <vector>
+
 using namespace mox;
 
 template <class LockableObject>
@@ -1500,3 +1503,499 @@ TEST_F(Bindings, test_delete_runtime_property_host_in_autodetach_cyclic_binding_
     EXPECT_EQ(BindingState::Detached, group->at(0u)->getState());
     EXPECT_EQ(BindingState::Detached, group->at(1u)->getState());
 }
+
+TEST_F(Bindings, test_update_scope_evaluates_binding_once)
+{
+    WritableTest o1;
+    WritableTest o2(2);
+    WritableTest o3(3);
+
+    int evaluationCount = 0;
+    auto expression = [&o2, &o3, &evaluationCount]()
+    {
+        ++evaluationCount;
+        return Variant(int(o2.writable) * int(o3.writable));
+    };
+    auto binding = ExpressionBinding::bindPermanent(o1.writable, expression);
+    EXPECT_EQ(6, int(o1.writable));
+    evaluationCount = 0;
+
+    // The change signals are emitted after the binding is evaluated.
+    std::vector<int> targetOnChange;
+    auto onChanged = [&o1, &targetOnChange]()
+    {
+        targetOnChange.push_back(int(o1.writable));
+    };
+    EXPECT_NOT_NULL(o2.writable.changed.connect(onChanged));
+    EXPECT_NOT_NULL(o3.writable.changed.connect(onChanged));
+
+    {
+        PropertyUpdateScope updates;
+        o2.writable = 10;
+        {
+            PropertyUpdateScope nested;
+            o3.writable = 5;
+        }
+        EXPECT_TRUE(PropertyUpdateScope::isActive());
+        EXPECT_EQ(6, int(o1.writable));
+        EXPECT_EQ(0, evaluationCount);
+        EXPECT_TRUE(targetOnChange.empty());
+    }
+    EXPECT_FALSE(PropertyUpdateScope::isActive());
+    EXPECT_EQ(50, int(o1.writable));
+    EXPECT_EQ(1, evaluationCount);
+    EXPECT_EQ(std::vector<int>({50, 50}), targetOnChange);
+}
+
+TEST_F(Bindings, test_update_scope_emits_rebound_property_change_once)
+{
+    WritableTest o1;
+    WritableTest o2(2);
+    WritableTest o3(3);
+    auto binding = ExpressionBinding::bindPermanent(o1.writable, [&o2, &o3]() { return Variant(int(o2.writable) * int(o3.writable)); });
+    EXPECT_EQ(6, int(o1.writable));
+
+    std::vector<int> changes;
+    EXPECT_NOT_NULL(o1.writable.changed.connect([&changes](int value) { changes.push_back(value); }));
+
+    // The binding re-evaluates the property written in the scope, and propagates its change.
+    {
+        PropertyUpdateScope updates;
+        o1.writable = 7;
+        o2.writable = 10;
+    }
+    EXPECT_EQ(30, int(o1.writable));
+    EXPECT_EQ(std::vector<int>({30}), changes);
+}
+
+TEST_F(Bindings, test_update_scope_skips_restored_property_change)
+{
+    WritableTest o1(1);
+    WritableTest o2(1);
+    int changeCount = 0;
+    auto onChanged = [&changeCount]()
+    {
+        ++changeCount;
+    };
+    EXPECT_NOT_NULL(o1.writable.changed.connect(onChanged));
+    EXPECT_NOT_NULL(o2.writable.changed.connect(onChanged));
+
+    {
+        PropertyUpdateScope updates;
+        o1.writable = 2;
+        o1.writable = 1;
+        PropertyRef<int>(o2.writable) = 2;
+        PropertyRef<int>(o2.writable) = 1;
+    }
+    EXPECT_EQ(0, changeCount);
+
+    {
+        PropertyUpdateScope updates;
+        o1.writable = 2;
+        o1.writable = 3;
+    }
+    EXPECT_EQ(1, changeCount);
+}
+
+TEST_F(Bindings, test_update_scope_with_property_destroyed_in_scope)
+{
+    WritableTest o1;
+    auto o2 = std::make_unique<WritableTest>(2);
+    WritableTest o3(3);
+    auto binding = ExpressionBinding::bindPermanent(o1.writable, [&o3]() { return Variant(int(o3.writable)); });
+
+    {
+        PropertyUpdateScope updates;
+        o2->writable = 10;
+        o3.writable = 4;
+        o2.reset();
+    }
+    EXPECT_EQ(4, int(o1.writable));
+}
+
+TEST_F(Bindings, test_update_scope_with_binding_loop)
+{
+    WritableTest o1;
+    WritableTest o2(10);
+
+    auto b1 = PropertyBinding::bindPermanent(o2.writable, o1.writable);
+    auto binding = ExpressionBinding::bindPermanent(o1.writable, [&o2]() { return Variant(int(o2.writable) % 3); });
+
+    // The commit rethrows the binding loop, and closes the scope.
+    {
+        PropertyUpdateScope updates;
+        o1.writable = 3;
+        EXPECT_THROW(updates.commit(), Exception);
+        EXPECT_FALSE(PropertyUpdateScope::isActive());
+    }
+
+    // The destructor swallows the binding loop.
+    {
+        PropertyUpdateScope updates;
+        o1.writable = 4;
+    }
+    EXPECT_FALSE(PropertyUpdateScope::isActive());
+
+    // The scopes left no stale state behind.
+    {
+        PropertyUpdateScope updates;
+        o2.writable = 2;
+    }
+}
+
+TEST_F(Bindings, test_diamond_binding_evaluated_once)
+{
+    WritableTest source(1);
+    WritableTest left;
+    WritableTest right;
+    WritableTest sink;
+
+    ExpressionBinding::bindPermanent(left.writable, [&source]() { return Variant(int(source.writable) * 2); });
+    ExpressionBinding::bindPermanent(right.writable, [&source]() { return Variant(int(source.writable) * 3); });
+
+    int evaluationCount = 0;
+    std::vector<int> sinkValues;
+    auto expression = [&left, &right, &evaluationCount]()
+    {
+        ++evaluationCount;
+        return Variant(int(left.writable) + int(right.writable));
+    };
+    ExpressionBinding::bindPermanent(sink.writable, expression);
+    EXPECT_NOT_NULL(sink.writable.changed.connect([&sinkValues](int value) { sinkValues.push_back(value); }));
+    EXPECT_EQ(5, int(sink.writable));
+
+    evaluationCount = 0;
+    source.writable = 2;
+    // The sink is evaluated after both sides are updated, and never sees a mixed state.
+    EXPECT_EQ(1, evaluationCount);
+    EXPECT_EQ(std::vector<int>({10}), sinkValues);
+}
+
+TEST_F(Bindings, test_binding_switching_to_higher_ranked_dependency)
+{
+    WritableTest source(1);
+    WritableTest cond;
+    WritableTest a(100);
+    WritableTest b1;
+    WritableTest b2;
+    WritableTest b;
+    WritableTest target;
+
+    ExpressionBinding::bindPermanent(cond.writable, [&source]() { return Variant(int(source.writable) > 1 ? 0 : 1); });
+    ExpressionBinding::bindPermanent(b1.writable, [&source]() { return Variant(int(source.writable) + 1); });
+    ExpressionBinding::bindPermanent(b2.writable, [&b1]() { return Variant(int(b1.writable) + 1); });
+    ExpressionBinding::bindPermanent(b.writable, [&b2]() { return Variant(int(b2.writable) + 1); });
+
+    std::vector<int> seen;
+    auto expression = [&cond, &a, &b, &seen]()
+    {
+        auto value = int(cond.writable) ? int(a.writable) : int(b.writable);
+        seen.push_back(value);
+        return Variant(value);
+    };
+    ExpressionBinding::bindPermanent(target.writable, expression);
+    std::vector<int> targetValues;
+    EXPECT_NOT_NULL(target.writable.changed.connect([&targetValues](int value) { targetValues.push_back(value); }));
+    EXPECT_EQ(100, int(target.writable));
+
+    // The binding switches to a dependency ranked above it. The value read before the dependency
+    // is evaluated is dropped, and is not counted as a binding loop.
+    seen.clear();
+    EXPECT_NO_THROW(source.writable = 5);
+    EXPECT_EQ(8, int(target.writable));
+    EXPECT_EQ(8, seen.back());
+    EXPECT_EQ(std::vector<int>({8}), targetValues);
+}
+
+namespace
+{
+
+// A wide binding graph: a source, a set of bindings on the source, and a sink bound to all of them.
+struct WideBindingGraph
+{
+    WritableTest source;
+    std::vector<std::unique_ptr<WritableTest>> wide;
+    WritableTest sink;
+    int sinkEvaluations = 0;
+
+    explicit WideBindingGraph(int width)
+    {
+        for (int i = 0; i < width; ++i)
+        {
+            wide.push_back(std::make_unique<WritableTest>());
+            ExpressionBinding::bindPermanent(wide.back()->writable, [this, i]() { return Variant(int(source.writable) + i); });
+        }
+        auto sum = [this]()
+        {
+            ++sinkEvaluations;
+            int result = 0;
+            for (auto& property : wide)
+            {
+                result += int(property->writable);
+            }
+            return Variant(result);
+        };
+        ExpressionBinding::bindPermanent(sink.writable, sum);
+    }
+};
+
+// A deep binding graph: a chain of bindings, each incrementing the value of the previous one.
+struct BindingChain
+{
+    std::vector<std::unique_ptr<WritableTest>> chain;
+
+    explicit BindingChain(int depth)
+    {
+        chain.push_back(std::make_unique<WritableTest>());
+        for (int i = 1; i < depth; ++i)
+        {
+            chain.push_back(std::make_unique<WritableTest>());
+            auto& previous = *chain[i - 1];
+            ExpressionBinding::bindPermanent(chain.back()->writable, [&previous]() { return Variant(int(previous.writable) + 1); });
+        }
+    }
+};
+
+// A binding reading many sources, updated through one of them.
+struct SumOfSources
+{
+    std::vector<std::unique_ptr<WritableTest>> sources;
+    WritableTest target;
+
+    explicit SumOfSources(int sourceCount)
+    {
+        for (int i = 0; i < sourceCount; ++i)
+        {
+            sources.push_back(std::make_unique<WritableTest>());
+        }
+        auto sum = [this]()
+        {
+            int result = 0;
+            for (auto& source : sources)
+            {
+                result += int(source->writable);
+            }
+            return Variant(result);
+        };
+        ExpressionBinding::bindPermanent(target.writable, sum);
+    }
+};
+
+}
+
+TEST_F(Bindings, test_binding_graph_propagation)
+{
+    constexpr int width = 200;
+    constexpr int depth = 200;
+    constexpr int updateCount = 10;
+
+    WideBindingGraph graph(width);
+    graph.sinkEvaluations = 0;
+    for (int i = 1; i <= updateCount; ++i)
+    {
+        graph.source.writable = i;
+    }
+    EXPECT_EQ(updateCount, graph.sinkEvaluations);
+    EXPECT_EQ(width * updateCount + width * (width - 1) / 2, int(graph.sink.writable));
+
+    BindingChain chain(depth);
+    for (int i = 1; i <= updateCount; ++i)
+    {
+        chain.chain.front()->writable = i;
+    }
+    EXPECT_EQ(updateCount + depth - 1, int(chain.chain.back()->writable));
+}
+
+TEST_F(Bindings, test_expression_binding_drops_unused_dependencies)
+{
+    WritableTest target;
+    WritableTest selector(1);
+    WritableTest odd(10);
+    WritableTest even(20);
+
+    int evaluationCount = 0;
+    auto expression = [&selector, &odd, &even, &evaluationCount]()
+    {
+        ++evaluationCount;
+        return (int(selector.writable) % 2) ? odd.writable.get() : even.writable.get();
+    };
+    ExpressionBinding::bindPermanent(target.writable, expression);
+    EXPECT_EQ(10, int(target.writable));
+
+    // The expression does not read the even property.
+    evaluationCount = 0;
+    even.writable = 21;
+    EXPECT_EQ(0, evaluationCount);
+
+    selector.writable = 2;
+    EXPECT_EQ(1, evaluationCount);
+    EXPECT_EQ(21, int(target.writable));
+
+    // The odd property is no longer a dependency.
+    odd.writable = 11;
+    EXPECT_EQ(1, evaluationCount);
+    even.writable = 22;
+    EXPECT_EQ(2, evaluationCount);
+    EXPECT_EQ(22, int(target.writable));
+}
+
+TEST_F(Bindings, test_stable_expression_reevaluation)
+{
+    constexpr int updateCount = 100;
+
+    SumOfSources sum(16);
+    for (int i = 1; i <= updateCount; ++i)
+    {
+        sum.sources.front()->writable = i;
+    }
+    EXPECT_EQ(updateCount, int(sum.target.writable));
+}
+
+TEST_F(Bindings, test_lazy_binding_evaluated_on_read)
+{
+    WritableTest source(1);
+    WritableTest target;
+
+    int evaluationCount = 0;
+    auto binding = ExpressionBinding::create([&source, &evaluationCount]()
+    {
+        ++evaluationCount;
+        return Variant(int(source.writable) * 10);
+    }, true);
+    binding->setLazy(true);
+    EXPECT_TRUE(binding->isLazy());
+    binding->attach(target.writable);
+    EXPECT_EQ(10, int(target.writable));
+
+    std::vector<int> targetValues;
+    EXPECT_NOT_NULL(target.writable.changed.connect([&targetValues](int value) { targetValues.push_back(value); }));
+
+    evaluationCount = 0;
+    for (int i = 2; i <= 100; ++i)
+    {
+        source.writable = i;
+    }
+    EXPECT_EQ(0, evaluationCount);
+    EXPECT_TRUE(targetValues.empty());
+
+    // The read evaluates the binding once, and emits the change signal once.
+    EXPECT_EQ(1000, int(target.writable));
+    EXPECT_EQ(1000, PropertyRef<int>(target.writable).get());
+    EXPECT_EQ(1, evaluationCount);
+    EXPECT_EQ(std::vector<int>({1000}), targetValues);
+
+    // Turning off the lazy mode evaluates on change.
+    source.writable = 5;
+    binding->setLazy(false);
+    EXPECT_EQ(2, evaluationCount);
+    source.writable = 6;
+    EXPECT_EQ(3, evaluationCount);
+    EXPECT_EQ(60, int(target.writable));
+}
+
+TEST_F(Bindings, test_write_supersedes_dirty_lazy_binding)
+{
+    WritableTest source(1);
+    WritableTest target;
+
+    auto binding = ExpressionBinding::create([&source]() { return Variant(int(source.writable) * 10); }, true);
+    binding->setLazy(true);
+    binding->attach(target.writable);
+    EXPECT_EQ(10, int(target.writable));
+
+    std::vector<int> targetValues;
+    EXPECT_NOT_NULL(target.writable.changed.connect([&targetValues](int value) { targetValues.push_back(value); }));
+
+    // The typed setter drops the pending evaluation, same as the Variant setter does.
+    source.writable = 2;
+    PropertyRef<int>(target.writable).set(7);
+    EXPECT_EQ(7, int(target.writable));
+
+    source.writable = 3;
+    target.writable = 8;
+    EXPECT_EQ(8, PropertyRef<int>(target.writable).get());
+    EXPECT_EQ(std::vector<int>({7, 8}), targetValues);
+}
+
+TEST_F(Bindings, test_lazy_binding_chain)
+{
+    WritableTest source(1);
+    WritableTest middle;
+    WritableTest sink;
+
+    auto first = ExpressionBinding::create([&source]() { return Variant(int(source.writable) + 1); }, true);
+    first->setLazy(true);
+    first->attach(middle.writable);
+    auto second = ExpressionBinding::create([&middle]() { return Variant(int(middle.writable) * 2); }, true);
+    second->setLazy(true);
+    second->attach(sink.writable);
+    EXPECT_EQ(4, int(sink.writable));
+
+    source.writable = 10;
+    // Reading the sink pulls the middle property.
+    EXPECT_EQ(22, int(sink.writable));
+    EXPECT_EQ(11, int(middle.writable));
+}
+
+TEST_F(Bindings, test_lazy_binding_with_eager_dependent)
+{
+    WritableTest source(1);
+    WritableTest middle;
+    WritableTest sink;
+
+    int evaluationCount = 0;
+    auto lazy = ExpressionBinding::create([&source, &evaluationCount]()
+    {
+        ++evaluationCount;
+        return Variant(int(source.writable) + 1);
+    }, true);
+    lazy->setLazy(true);
+    lazy->attach(middle.writable);
+    ExpressionBinding::bindPermanent(sink.writable, [&middle]() { return Variant(int(middle.writable) * 2); });
+
+    // The eager binding on the middle property needs the lazy binding evaluated on change.
+    evaluationCount = 0;
+    source.writable = 10;
+    EXPECT_EQ(1, evaluationCount);
+    EXPECT_EQ(22, int(sink.writable));
+}
+
+TEST_F(Bindings, DISABLED_benchmark_binding_graph_propagation)
+{
+    constexpr int updateCount = 100;
+
+    WideBindingGraph graph(200);
+    auto updateWide = [&graph]()
+    {
+        for (int i = 1; i <= updateCount; ++i)
+        {
+            graph.source.writable = i;
+        }
+    };
+    Benchmark::recordDuration("wide_update_us", Benchmark::measure(updateWide) / updateCount);
+
+    BindingChain chain(200);
+    auto updateDeep = [&chain]()
+    {
+        for (int i = 1; i <= updateCount; ++i)
+        {
+            chain.chain.front()->writable = i;
+        }
+    };
+    Benchmark::recordDuration("deep_update_us", Benchmark::measure(updateDeep) / updateCount);
+}
+
+TEST_F(Bindings, DISABLED_benchmark_stable_expression_reevaluation)
+{
+    constexpr int updateCount = 10000;
+
+    SumOfSources sum(16);
+    auto update = [&sum]()
+    {
+        for (int i = 1; i <= updateCount; ++i)
+        {
+            sum.sources.front()->writable = i;
+        }
+    };
+    Benchmark::recordRate("reevaluations_per_ms", updateCount, Benchmark::measure(update));
+}
@@ -21,6 +21,11 @@
 #include <mox/core/meta/core/variant.hpp>
 #include <mox/core/meta/class/metaobject.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+
 namespace converter_test
 {
 
@@ -208,3 +213,140 @@ TEST_F(Converters, test_metaobject_conversion)
     converter_test::Derived *pderived = arg;
     EXPECT_NULL(pderived);
 }
+
+TEST_F(Converters, test_converter_registered_after_lookup)
+{
+    struct LateSource
+    {
+        int16_t value = 0;
+    };
+    auto lateSource = mox::registerMetaType<LateSource>();
+    auto userType = mox::metaType<converter_test::UserType>();
+    EXPECT_NULL(mox::MetatypeDescriptor::findConverter(lateSource, userType));
+
+    auto convert = [](LateSource value)
+    {
+        converter_test::UserType result;
+        result.v1 = value.value;
+        return result;
+    };
+    EXPECT_TRUE((mox::registerConverter<LateSource, converter_test::UserType>(convert)));
+    EXPECT_NOT_NULL(mox::MetatypeDescriptor::findConverter(lateSource, userType));
+    EXPECT_EQ(mox::MetatypeDescriptor::findConverter(lateSource, userType), mox::MetatypeDescriptor::get(lateSource).findConverterTo(userType));
+}
+
+namespace
+{
+
+// Converts conversionCount integers to double on each of threadCount threads, and returns the
+// number of failed conversions.
+int convertFromThreads(int threadCount, int conversionCount)
+{
+    std::atomic_int failures = 0;
+    auto converterThread = [&failures, conversionCount]()
+    {
+        for (int i = 0; i < conversionCount; ++i)
+        {
+            auto converter = mox::MetatypeDescriptor::findConverter(mox::Metatype::Int32, mox::Metatype::Double);
+            int32_t value = i;
+            mox::MetaValue result = converter ? converter->convert(&value) : mox::MetaValue();
+            if (!result.has_value() || std::any_cast<double>(result) != double(i))
+            {
+                ++failures;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(converterThread);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    return failures;
+}
+
+}
+
+TEST_F(Converters, test_convert_from_multiple_threads)
+{
+    EXPECT_EQ(0, convertFromThreads(4, 20000));
+}
+
+namespace converter_test
+{
+template <int Index>
+struct LateType
+{
+    int32_t value = Index;
+};
+
+template <int... Index>
+void registerLateConverters(std::integer_sequence<int, Index...>)
+{
+    auto registrar = [](auto late)
+    {
+        using LateType = decltype(late);
+        mox::registerMetaType<LateType>();
+        auto convert = [](LateType value)
+        {
+            UserType result;
+            result.v1 = value.value;
+            return result;
+        };
+        return mox::registerConverter<LateType, UserType>(convert);
+    };
+    std::array<bool, sizeof...(Index)> registered = {{registrar(LateType<Index>())...}};
+    for (auto result : registered)
+    {
+        EXPECT_TRUE(result);
+    }
+}
+}
+
+TEST_F(Converters, test_register_converters_during_lookup)
+{
+    std::atomic_bool done = false;
+    std::atomic_int failures = 0;
+
+    auto converterThread = [&done, &failures]()
+    {
+        while (!done)
+        {
+            if (!mox::MetatypeDescriptor::findConverter(mox::Metatype::Int32, mox::Metatype::Double))
+            {
+                ++failures;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 2; ++i)
+    {
+        threads.emplace_back(converterThread);
+    }
+    converter_test::registerLateConverters(std::make_integer_sequence<int, 32>());
+    done = true;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(0, failures);
+    auto late = mox::metaType<converter_test::LateType<31>>();
+    EXPECT_NOT_NULL(mox::MetatypeDescriptor::findConverter(late, mox::metaType<converter_test::UserType>()));
+}
+
+TEST_F(Converters, DISABLED_benchmark_convert_from_multiple_threads)
+{
+    constexpr int conversionCount = 200000;
+    const unsigned maxThreads = std::max(4u, std::thread::hardware_concurrency());
+    for (unsigned threadCount = 1u; threadCount <= maxThreads; threadCount *= 2)
+    {
+        auto elapsed = Benchmark::measure([threadCount]() { convertFromThreads(int(threadCount), conversionCount); });
+        Benchmark::recordRate("conversions_per_ms_" + std::to_string(threadCount) + "_threads", int64_t(threadCount) * conversionCount, elapsed);
+    }
+}
@@ -28,7 +28,7 @@ TEST(MetaDataEnum, test_enumerate_default_metatypes)
     std::array<std::string, int(mox::Metatype::UserType)> typeNames = {
         "void"s, "bool"s, "char"s, "byte"s, "short"s, "word"s, "int"s, "uint"s, "int64"s, "uint64"s,
         "float"s, "double"s, "std::string"s, "literal"s, "void*"s, "byte*"s, "int*"s, "int64*"s,
-        "vector<int32>"s
+        "vector<int32>"s, "buffer<int32>"s
     };
     auto it = typeNames.begin();
     auto scanner = [&it, &typeNames](const auto& des)
@@ -20,6 +20,9 @@
 #include <mox/core/event_handling/event.hpp>
 #include <mox/core/event_handling/event_queue.hpp>
 
+#include <chrono>
+#include <thread>
+
 using namespace mox;
 
 class NoCompressEvent : public Event
@@ -139,3 +142,49 @@ TEST(EventQueue, test_process_event_priority_changes_order)
     };
     queue.process(checker);
 }
+
+TEST(EventQueue, test_posted_events_request_one_wakeup)
+{
+    EventQueue queue;
+    ObjectSharedPtr handler = Object::create();
+
+    EXPECT_TRUE(queue.post(make_event<NoCompressEvent>(handler, EventType::Base)));
+    EXPECT_FALSE(queue.post(make_event<NoCompressEvent>(handler, EventType::UserType)));
+    EXPECT_FALSE(queue.post(make_event<NoCompressEvent>(handler, EventType::Base, Event::Priority::Urgent)));
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(3u, queue.size());
+
+    std::vector<EventType> processed;
+    auto collector = [&processed](Event& event)
+    {
+        processed.push_back(event.type());
+    };
+    queue.process(collector);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ((std::vector<EventType>{EventType::Base, EventType::Base, EventType::UserType}), processed);
+
+    // Processing re-arms the wakeup.
+    EXPECT_TRUE(queue.post(make_event<NoCompressEvent>(handler, EventType::Base)));
+    queue.cancelWakeUp();
+    EXPECT_TRUE(queue.post(make_event<NoCompressEvent>(handler, EventType::Base)));
+}
+
+TEST(EventQueue, test_posted_event_ordered_by_post_time)
+{
+    EventQueue queue;
+    ObjectSharedPtr handler = Object::create();
+
+    // The event posted first is processed first, even if it is fetched after the pushed one.
+    queue.post(make_event<NoCompressEvent>(handler, EventType::UserType));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    queue.push(make_event<NoCompressEvent>(handler, EventType::Base));
+    EXPECT_EQ(2u, queue.size());
+
+    std::vector<EventType> processed;
+    auto collector = [&processed](Event& event)
+    {
+        processed.push_back(event.type());
+    };
+    queue.process(collector);
+    EXPECT_EQ((std::vector<EventType>{EventType::UserType, EventType::Base}), processed);
+}
@@ -101,6 +101,50 @@ public:
     }
 };
 
+template <int Index>
+class GeneratedClass : public MetaObject
+{
+public:
+    MetaInfo(GeneratedClass, MetaObject)
+    {
+    };
+};
+
+template <int Index>
+class EagerGeneratedClass : public MetaObject
+{
+public:
+    MetaInfo(EagerGeneratedClass, MetaObject)
+    {
+    };
+};
+
+template <int... Index>
+void constructMetaClasses(std::integer_sequence<int, Index...>)
+{
+    std::array<std::pair<Metatype, Metatype>, sizeof...(Index)> metaTypes = {{registerMetaClass<GeneratedClass<Index>>()...}};
+    UNUSED(metaTypes);
+}
+
+template <int Index>
+const metainfo::MetaClass* constructAndRegisterMetaClass()
+{
+    // Looking up the metaclass by name right after its construction registers the name under
+    // the metadata lock, the way the eager registration did.
+    auto metaTypes = registerMetaClass<EagerGeneratedClass<Index>>();
+    return metainfo::MetaClass::find(MetatypeDescriptor::get(metaTypes.first).name());
+}
+
+template <int... Index>
+void constructMetaClassesEagerly(std::integer_sequence<int, Index...>)
+{
+    std::array<const metainfo::MetaClass*, sizeof...(Index)> metaClasses = {{constructAndRegisterMetaClass<Index>()...}};
+    for (auto metaClass : metaClasses)
+    {
+        EXPECT_NOT_NULL(metaClass);
+    }
+}
+
 class MetaClasses : public UnitTest
 {
 protected:
@@ -219,3 +263,76 @@ TEST_F(MetaClasses, test_metatype_superclass)
     EXPECT_TRUE(secondObject.derivesFrom(derived));
     EXPECT_TRUE(secondObject.derivesFrom(metaObject));
 }
+
+TEST_F(MetaClasses, test_derives_from_self_and_unrelated)
+{
+    const auto* moSecondObject = SecondObject::StaticMetaClass::get();
+    const auto* moObjectDerivedClass = ObjectDerivedClass::StaticMetaClass::get();
+    const auto* moOtherBaseClass = OtherBaseClass::StaticMetaClass::get();
+
+    EXPECT_TRUE(moSecondObject->derivesFrom(*moSecondObject));
+    EXPECT_TRUE(moSecondObject->derivesFrom(*moOtherBaseClass));
+    EXPECT_FALSE(moSecondObject->derivesFrom(*moObjectDerivedClass));
+    EXPECT_FALSE(moObjectDerivedClass->derivesFrom(*moSecondObject));
+    EXPECT_FALSE(moOtherBaseClass->derivesFrom(*moSecondObject));
+}
+
+TEST_F(MetaClasses, test_repeated_subclass_checks)
+{
+    const auto& base = metatypeDescriptor<TBaseClass>();
+    const auto& secondObject = metatypeDescriptor<SecondObject>();
+    const auto& objectDerived = metatypeDescriptor<ObjectDerivedClass>();
+    constexpr int checks = 100;
+    int hits = 0;
+
+    for (int i = 0; i < checks; ++i)
+    {
+        hits += secondObject.derivesFrom(base) ? 1 : 0;
+        hits += secondObject.derivesFrom(objectDerived) ? 1 : 0;
+    }
+    EXPECT_EQ(checks, hits);
+}
+
+TEST_F(MetaClasses, test_metaclass_names_registered_on_lookup)
+{
+    // The metaclasses are constructed without registering their names, the names are registered
+    // on the first lookup by name.
+    constructMetaClassesEagerly(std::make_integer_sequence<int, 128>());
+    constructMetaClasses(std::make_integer_sequence<int, 128>());
+
+    const auto* metaClass = metainfo::MetaClass::find(MetatypeDescriptor::get(metaType<GeneratedClass<0>>()).name());
+    EXPECT_EQ(GeneratedClass<0>::StaticMetaClass::get(), metaClass);
+    EXPECT_EQ(GeneratedClass<127>::StaticMetaClass::get(), metainfo::MetaClass::find(MetatypeDescriptor::get(metaType<GeneratedClass<127>>()).name()));
+}
+
+TEST_F(MetaClasses, DISABLED_benchmark_subclass_checks)
+{
+    const auto& base = metatypeDescriptor<TBaseClass>();
+    const auto& secondObject = metatypeDescriptor<SecondObject>();
+    const auto& objectDerived = metatypeDescriptor<ObjectDerivedClass>();
+    constexpr int checks = 100000;
+
+    int hits = 0;
+    auto check = [&]()
+    {
+        for (int i = 0; i < checks; ++i)
+        {
+            hits += secondObject.derivesFrom(base) ? 1 : 0;
+            hits += secondObject.derivesFrom(objectDerived) ? 1 : 0;
+        }
+    };
+    Benchmark::recordRate("subclass_checks_per_ms", 2 * checks, Benchmark::measure(check));
+}
+
+TEST_F(MetaClasses, DISABLED_benchmark_metaclass_startup_cost)
+{
+    // The metaclasses are measured only if no other test constructed them before. Eager
+    // registration costs the construction and the name registration together.
+    auto eager = Benchmark::measure([]() { constructMetaClassesEagerly(std::make_integer_sequence<int, 128>()); });
+    auto construction = Benchmark::measure([]() { constructMetaClasses(std::make_integer_sequence<int, 128>()); });
+    auto registration = Benchmark::measure([]() { metainfo::MetaClass::find(MetatypeDescriptor::get(metaType<GeneratedClass<0>>()).name()); });
+
+    Benchmark::recordDuration("eager_registration_us_128_metaclasses", eager);
+    Benchmark::recordDuration("construction_us_128_metaclasses", construction);
+    Benchmark::recordDuration("name_registration_us_128_metaclasses", registration);
+}
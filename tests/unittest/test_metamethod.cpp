@@ -195,3 +195,93 @@ TEST_F(MetaMethods, test_invoked_with_convertible_arguments)
     EXPECT_TRUE(ret);
     EXPECT_EQ(123, *ret);
 }
+
+TEST_F(MetaMethods, test_name_index_holds_inherited_methods)
+{
+    const auto* mc = Mixin::StaticMetaClass::get();
+
+    const auto& methods = mc->findMethods("testFunc1");
+    ASSERT_EQ(2u, methods.size());
+    EXPECT_EQ(&TestMixin::StaticMetaClass::testFunc1, methods[0]);
+    EXPECT_EQ(&TestSecond::StaticMetaClass::testFunc1, methods[1]);
+
+    EXPECT_EQ(1u, mc->findMethods("staticFunc").size());
+    EXPECT_TRUE(mc->findMethods("whatever").empty());
+    EXPECT_TRUE(TestSecond::StaticMetaClass::get()->findMethods("testFunc2").empty());
+}
+
+TEST_F(MetaMethods, test_prepared_invoke)
+{
+    Mixin mixin;
+
+    auto testFunc2 = metainfo::prepareInvoke<Mixin>("testFunc2");
+    ASSERT_TRUE(testFunc2.isValid());
+    EXPECT_EQ(&TestMixin::StaticMetaClass::testFunc2, testFunc2.method());
+    for (int i = 0; i < 3; ++i)
+    {
+        auto ret = testFunc2(mixin);
+        EXPECT_TRUE(ret);
+        EXPECT_EQ(1234321, *ret);
+    }
+
+    // Convertible arguments.
+    auto staticFunc = metainfo::prepareInvoke<Mixin, std::string>("staticFunc");
+    ASSERT_TRUE(staticFunc.isValid());
+    auto ret = staticFunc(mixin, "987");
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(987, *ret);
+
+    // Not invocable.
+    auto invalid = metainfo::prepareInvoke<Mixin>("staticFunc");
+    EXPECT_FALSE(invalid.isValid());
+    EXPECT_FALSE(invalid(mixin));
+    EXPECT_FALSE(metainfo::prepareInvoke<Mixin>("whatever").isValid());
+}
+
+TEST_F(MetaMethods, test_invoke_by_name_repeatedly)
+{
+    Mixin mixin;
+    constexpr int invokes = 100;
+    int sum = 0;
+
+    for (int i = 0; i < invokes; ++i)
+    {
+        auto ret = metainfo::invoke(mixin, "staticFunc", i);
+        sum += (ret && *ret == i) ? 1 : 0;
+    }
+    EXPECT_EQ(invokes, sum);
+
+    sum = 0;
+    auto prepared = metainfo::prepareInvoke<Mixin, int>("staticFunc");
+    for (int i = 0; i < invokes; ++i)
+    {
+        auto ret = prepared(mixin, i);
+        sum += (ret && *ret == i) ? 1 : 0;
+    }
+    EXPECT_EQ(invokes, sum);
+}
+
+TEST_F(MetaMethods, DISABLED_benchmark_invoke_by_name)
+{
+    Mixin mixin;
+    constexpr int invokes = 10000;
+
+    auto invokeByName = [&mixin]()
+    {
+        for (int i = 0; i < invokes; ++i)
+        {
+            metainfo::invoke(mixin, "staticFunc", i);
+        }
+    };
+    Benchmark::recordRate("invokes_by_name_per_ms", invokes, Benchmark::measure(invokeByName));
+
+    auto prepared = metainfo::prepareInvoke<Mixin, int>("staticFunc");
+    auto invokePrepared = [&mixin, &prepared]()
+    {
+        for (int i = 0; i < invokes; ++i)
+        {
+            prepared(mixin, i);
+        }
+    };
+    Benchmark::recordRate("prepared_invokes_per_ms", invokes, Benchmark::measure(invokePrepared));
+}
@@ -19,6 +19,9 @@
 #include "test_framework.h"
 #include <mox/core/meta/core/metatype_descriptor.hpp>
 
+#include <thread>
+#include <utility>
+
 using namespace mox;
 
 struct UserStruct
@@ -29,6 +32,29 @@ class UserClass
 {
 };
 
+template <size_t N>
+struct ManyType
+{
+};
+
+struct RacingType
+{
+};
+
+constexpr size_t ManyTypeCount = 1024u;
+
+template <size_t... Index>
+std::vector<Metatype> registerManyTypes(std::index_sequence<Index...>)
+{
+    return {registerMetaType<ManyType<Index>>()...};
+}
+
+template <size_t... Index>
+size_t verifyManyTypes(const std::vector<Metatype>& types, std::index_sequence<Index...>)
+{
+    return (size_t(metaType<ManyType<Index>>() == types[Index]) + ...);
+}
+
 class Types : public UnitTest
 {
 protected:
@@ -172,3 +198,57 @@ TEST_F(Types, test_user_types)
     type = &metatypeDescriptor<UserClass>();
     EXPECT_GE(type->id(), Metatype::UserType);
 }
+
+TEST_F(Types, test_concurrent_registration_resolves_to_one_type)
+{
+    std::vector<Metatype> types(8u, Metatype::Invalid);
+    std::vector<std::thread> threads;
+    for (auto& type : types)
+    {
+        threads.emplace_back([&type]() { type = registerMetaType<RacingType>(); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (auto type : types)
+    {
+        EXPECT_EQ(metaType<RacingType>(), type);
+    }
+}
+
+TEST_F(Types, test_lookup_with_many_types)
+{
+    using Sequence = std::make_index_sequence<ManyTypeCount>;
+
+    const auto types = registerManyTypes(Sequence());
+    for (size_t i = 1u; i < types.size(); ++i)
+    {
+        EXPECT_EQ(static_cast<int>(types[i - 1]) + 1, static_cast<int>(types[i]));
+    }
+    EXPECT_EQ(types.front(), metaType<ManyType<0>>());
+    EXPECT_EQ(types.back(), metaType<ManyType<ManyTypeCount - 1>>());
+    EXPECT_EQ(types.back(), metatypeDescriptor<ManyType<ManyTypeCount - 1>>().id());
+    EXPECT_EQ(ManyTypeCount, verifyManyTypes(types, Sequence()));
+}
+
+TEST_F(Types, DISABLED_benchmark_lookup_with_many_types)
+{
+    using Sequence = std::make_index_sequence<ManyTypeCount>;
+
+    // The registration is measured only if no other test registered the types before.
+    std::vector<Metatype> types;
+    auto registration = Benchmark::measure([&types]() { types = registerManyTypes(Sequence()); });
+    Benchmark::recordDuration("registration_us_1024_types", registration);
+
+    constexpr size_t rounds = 100u;
+    auto lookup = [&types]()
+    {
+        for (size_t round = 0u; round < rounds; ++round)
+        {
+            verifyManyTypes(types, Sequence());
+        }
+    };
+    Benchmark::recordRate("lookups_per_ms", rounds * ManyTypeCount, Benchmark::measure(lookup));
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2017-2019 bitWelder
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see
+ * <http://www.gnu.org/licenses/>
+ */
+
+#include "test_framework.h"
+#include <mox/utils/containers/mpsc_queue.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(MpscQueueTests, test_empty_queue)
+{
+    mox::MpscQueue<int> test;
+    EXPECT_TRUE(test.empty());
+    int value = 0;
+    EXPECT_FALSE(test.pop(value));
+}
+
+TEST(MpscQueueTests, test_fifo_order)
+{
+    mox::MpscQueue<int> test;
+    test.push(1);
+    test.push(2);
+    test.push(3);
+    EXPECT_FALSE(test.empty());
+
+    int value = 0;
+    EXPECT_TRUE(test.pop(value));
+    EXPECT_EQ(1, value);
+    EXPECT_TRUE(test.pop(value));
+    EXPECT_EQ(2, value);
+    EXPECT_TRUE(test.pop(value));
+    EXPECT_EQ(3, value);
+    EXPECT_TRUE(test.empty());
+}
+
+TEST(MpscQueueTests, test_move_only_values)
+{
+    mox::MpscQueue<std::unique_ptr<int>> test;
+    test.push(std::make_unique<int>(10));
+    test.push(std::make_unique<int>(20));
+
+    std::unique_ptr<int> value;
+    ASSERT_TRUE(test.pop(value));
+    EXPECT_EQ(10, *value);
+
+    // The destructor destroys the remaining values.
+}
+
+TEST(MpscQueueTests, test_clear)
+{
+    auto shared = std::make_shared<int>(1);
+    mox::MpscQueue<std::shared_ptr<int>> test;
+    test.push(shared);
+    test.push(shared);
+    EXPECT_EQ(3, shared.use_count());
+
+    test.clear();
+    EXPECT_TRUE(test.empty());
+    EXPECT_EQ(1, shared.use_count());
+}
+
+namespace
+{
+
+// Pushes pushCount values from each of producerCount threads, and pops them while the producers
+// push. Returns the number of values popped from each producer, or -1 for a producer whose values
+// were popped out of order.
+std::vector<int> pushAndPop(mox::MpscQueue<std::pair<int, int>>& queue, int producerCount, int pushCount)
+{
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < producerCount; ++producer)
+    {
+        auto pusher = [&queue, producer, pushCount]()
+        {
+            for (int i = 0; i < pushCount; ++i)
+            {
+                queue.push({producer, i});
+            }
+        };
+        producers.emplace_back(pusher);
+    }
+
+    std::vector<int> popped(std::size_t(producerCount), 0);
+    int received = 0;
+    std::pair<int, int> value;
+    while (received < producerCount * pushCount)
+    {
+        if (!queue.pop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        auto& count = popped[std::size_t(value.first)];
+        count = (count == value.second) ? count + 1 : -1;
+        ++received;
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    return popped;
+}
+
+}
+
+TEST(MpscQueueTests, test_multiple_producers)
+{
+    constexpr int producerCount = 4;
+    constexpr int pushCount = 20000;
+    mox::MpscQueue<std::pair<int, int>> test;
+
+    // The values of each producer are popped in the order they were pushed.
+    const auto popped = pushAndPop(test, producerCount, pushCount);
+    EXPECT_TRUE(test.empty());
+    for (auto count : popped)
+    {
+        EXPECT_EQ(pushCount, count);
+    }
+}
+
+TEST(MpscQueueTests, DISABLED_benchmark_multiple_producers)
+{
+    constexpr int producerCount = 4;
+    constexpr int pushCount = 20000;
+    mox::MpscQueue<std::pair<int, int>> test;
+
+    auto elapsed = Benchmark::measure([&test]() { pushAndPop(test, producerCount, pushCount); });
+    Benchmark::recordRate("push_pop_per_ms", producerCount * pushCount, elapsed);
+}
@@ -18,9 +18,73 @@
 
 #include "test_framework.h"
 #include <mox/core/object.hpp>
+#include <mox/core/process/thread_interface.hpp>
+
+#include <chrono>
+#include <cstdlib>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
 using namespace mox;
 
+namespace
+{
+// The heap bytes in use by the process, or 0 if the C library does not report it.
+int64_t heapBytesInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return static_cast<int64_t>(mallinfo2().uordblks);
+#else
+    return 0;
+#endif
+}
+
+// Creates objectCount objects, and returns the heap bytes each takes. The first object creates
+// the static data of the class, and is not measured.
+template <class ObjectType>
+int64_t heapBytesPerObject(std::vector<std::shared_ptr<ObjectType>>& objects, int64_t objectCount)
+{
+    objects.reserve(std::size_t(objectCount));
+    objects.push_back(ObjectType::create());
+
+    const auto heapStart = heapBytesInUse();
+    for (int64_t i = 1; i < objectCount; ++i)
+    {
+        objects.push_back(ObjectType::create());
+    }
+    return (heapBytesInUse() - heapStart) / (objectCount - 1);
+}
+}
+
+class SlotObject : public Object
+{
+public:
+    static inline SignalTypeDecl<int32_t> IntSignalType;
+    Signal intSignal{*this, IntSignalType};
+    int slotCallCount = 0;
+
+    MetaInfo(SlotObject, Object)
+    {
+    };
+
+    static std::shared_ptr<SlotObject> create()
+    {
+        return createObject(new SlotObject);
+    }
+
+    void intSlot(int32_t)
+    {
+        ++slotCallCount;
+    }
+
+    int sum(int a, int b)
+    {
+        return a + b;
+    }
+};
+
 
 TEST(ObjectTest, test_api)
 {
@@ -54,3 +118,79 @@ TEST(ObjectTest, test_remove_child)
     parent->removeChild(*child1);
     EXPECT_EQ(1u, parent->childCount());
 }
+
+TEST(ObjectTest, test_object_footprint)
+{
+    constexpr int64_t objectCount = 1000;
+    std::vector<ObjectSharedPtr> objects;
+    std::vector<std::shared_ptr<SlotObject>> slotObjects;
+    const auto objectHeap = heapBytesPerObject(objects, objectCount);
+    const auto slotObjectHeap = heapBytesPerObject(slotObjects, objectCount);
+
+    for (auto& object : slotObjects)
+    {
+        EXPECT_FALSE(object->intSignal.hasConnections());
+    }
+    // An unconnected signal allocates nothing, it only adds its size to the object. Allow the
+    // allocator rounding on top of that.
+    const auto signalOverhead = static_cast<int64_t>(sizeof(SlotObject) - sizeof(Object));
+    EXPECT_LE(slotObjectHeap, objectHeap + signalOverhead + 2 * static_cast<int64_t>(alignof(std::max_align_t)));
+}
+
+TEST(ObjectTest, test_emit_to_object_slot)
+{
+    auto sender = SlotObject::create();
+    auto receiver = SlotObject::create();
+    EXPECT_TRUE(receiver->isInThisThread());
+    EXPECT_NOT_NULL(sender->intSignal.connect(*receiver, &SlotObject::intSlot));
+
+    constexpr int emitCount = 100;
+    for (int i = 0; i < emitCount; ++i)
+    {
+        sender->intSignal(int32_t(i));
+    }
+
+    // The slot is called directly, not deferred.
+    EXPECT_EQ(emitCount, receiver->slotCallCount);
+}
+
+TEST(ObjectTest, test_invoke_on_same_thread)
+{
+    registerMetaClass<SlotObject>();
+    auto object = SlotObject::create();
+
+    // Invoking on the thread of the object completes the future immediately.
+    auto sum = invokeOn(object, &SlotObject::sum, 1, 2);
+    EXPECT_EQ(std::future_status::ready, sum.wait_for(std::chrono::seconds(0)));
+    EXPECT_EQ(3, int(sum.get()));
+
+    auto lambda = invokeOn(object, []() { return 10; });
+    EXPECT_EQ(10, int(lambda.get()));
+}
+
+TEST(ObjectTest, DISABLED_benchmark_object_footprint)
+{
+    std::vector<ObjectSharedPtr> objects;
+    const auto objectHeap = heapBytesPerObject(objects, 1000);
+
+    RecordProperty("object_size_bytes", static_cast<int>(sizeof(Object)));
+    RecordProperty("signal_size_bytes", static_cast<int>(sizeof(Signal)));
+    RecordProperty("heap_bytes_per_object", static_cast<int>(objectHeap));
+}
+
+TEST(ObjectTest, DISABLED_benchmark_emit_to_object_slot)
+{
+    auto sender = SlotObject::create();
+    auto receiver = SlotObject::create();
+    sender->intSignal.connect(*receiver, &SlotObject::intSlot);
+
+    constexpr int emitCount = 100000;
+    auto emitAll = [&sender]()
+    {
+        for (int i = 0; i < emitCount; ++i)
+        {
+            sender->intSignal(int32_t(i));
+        }
+    };
+    Benchmark::recordRate("object_slot_calls_per_ms", emitCount, Benchmark::measure(emitAll));
+}
@@ -20,6 +20,7 @@
 #include <mox/config/deftypes.hpp>
 #include <mox/utils/locks.hpp>
 #include <mox/core/meta/property/property.hpp>
+#include <mox/core/meta/property/binding/expression_binding.hpp>
 
 using namespace mox;
 
@@ -309,3 +310,141 @@ TEST_F(Properties, test_dynamic_property_pointer_held_after_host_deletion)
     EXPECT_NOT_NULL(runtimeInt);
     EXPECT_FALSE(runtimeInt->isValid());
 }
+
+TEST_F(Properties, test_typed_property_access)
+{
+    PropertyTest test;
+    PropertyRef<int> driver(test.driver);
+
+    int changeCount = 0;
+    auto onChanged = [&changeCount](int)
+    {
+        ++changeCount;
+    };
+    EXPECT_NOT_NULL(test.driver.changed.connect(onChanged));
+
+    EXPECT_EQ(0, driver.get());
+    driver = 10;
+    EXPECT_EQ(10, int(driver));
+    EXPECT_EQ(10, int(test.driver));
+    EXPECT_EQ(1, changeCount);
+    // Setting the same value does not emit the change signal.
+    driver = 10;
+    EXPECT_EQ(1, changeCount);
+
+    // An expression reading the typed reference subscribes to the property.
+    auto expression = [&driver]()
+    {
+        return Variant(driver.get() > 10);
+    };
+    EXPECT_NOT_NULL(ExpressionBinding::bindPermanent(test.boolValue, expression));
+    EXPECT_FALSE(bool(test.boolValue));
+    driver = 11;
+    EXPECT_TRUE(bool(test.boolValue));
+
+    // The read-only property is not writable through the typed reference.
+    PropertyRef<bool> status(test.status);
+    EXPECT_TRUE(status.get());
+    EXPECT_THROW(status.set(false), Exception);
+}
+
+TEST_F(Properties, test_typed_property_access_variant_provider)
+{
+    PropertyTest test;
+    auto property = test.setProperty(StandaloneIntPropertyType, Variant(1));
+    PropertyRef<int> value(*property);
+    EXPECT_EQ(1, value.get());
+    value = 5;
+    EXPECT_EQ(5, value.get());
+    EXPECT_EQ(5, int(property->get()));
+}
+
+TEST_F(Properties, test_typed_and_variant_access_on_same_property)
+{
+    PropertyTest test;
+    PropertyData<int> data{0};
+    Property property(test, StandaloneIntPropertyType, data);
+    PropertyRef<int> typed(property);
+
+    constexpr int accessCount = 100;
+    for (int i = 0; i < accessCount; ++i)
+    {
+        typed = typed + 1;
+    }
+    for (int i = 0; i < accessCount; ++i)
+    {
+        property = int(property) + 1;
+    }
+    EXPECT_EQ(2 * accessCount, int(property));
+    EXPECT_EQ(2 * accessCount, typed.get());
+}
+
+// Clamps the values written to the property, and counts the data accesses.
+class ClampingPropertyData : public PropertyData<int>
+{
+public:
+    explicit ClampingPropertyData()
+        : PropertyData<int>(0)
+    {
+    }
+
+    mutable int reads = 0;
+    int writes = 0;
+
+protected:
+    Variant getData() const override
+    {
+        ++reads;
+        return PropertyData<int>::getData();
+    }
+    void setData(const Variant& value) override
+    {
+        ++writes;
+        PropertyData<int>::setData(Variant(std::min(10, static_cast<int>(value))));
+    }
+};
+
+TEST_F(Properties, test_typed_access_uses_overridden_data_provider)
+{
+    PropertyTest test;
+    ClampingPropertyData data;
+    Property property(test, StandaloneIntPropertyType, data);
+    PropertyRef<int> typed(property);
+
+    typed = 100;
+    EXPECT_EQ(1, data.writes);
+    EXPECT_EQ(10, typed.get());
+    EXPECT_EQ(10, int(property));
+    EXPECT_LT(0, data.reads);
+
+    property = 5;
+    EXPECT_EQ(2, data.writes);
+    EXPECT_EQ(5, typed.get());
+}
+
+TEST_F(Properties, DISABLED_benchmark_typed_property_access)
+{
+    PropertyTest test;
+    PropertyData<int> data{0};
+    Property property(test, StandaloneIntPropertyType, data);
+    PropertyRef<int> typed(property);
+
+    constexpr int accessCount = 100000;
+    auto typedAccess = [&typed]()
+    {
+        for (int i = 0; i < accessCount; ++i)
+        {
+            typed = typed + 1;
+        }
+    };
+    Benchmark::recordDuration("typed_access_us", Benchmark::measure(typedAccess));
+
+    auto variantAccess = [&property]()
+    {
+        for (int i = 0; i < accessCount; ++i)
+        {
+            property = int(property) + 1;
+        }
+    };
+    Benchmark::recordDuration("variant_access_us", Benchmark::measure(variantAccess));
+}
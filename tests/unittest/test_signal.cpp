@@ -21,8 +21,13 @@
 #include <mox/core/meta/class/metaobject.hpp>
 #include <mox/core/meta/core/callable.hpp>
 #include <mox/core/meta/signal/signal.hpp>
+#include <mox/utils/containers/shared_buffer.hpp>
 
+#include <atomic>
+#include <memory>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 using namespace mox;
 
@@ -606,6 +611,33 @@ TEST_F(SignalTest, test_emit_metasignals)
     EXPECT_EQ(-1, metainfo::emit(sender, "sigV"));
 }
 
+TEST_F(SignalTest, test_prepared_emit_metasignals)
+{
+    SignalTestClass sender;
+    DerivedHolder receiver;
+    EXPECT_NOT_NULL(sender.sig2.connect(receiver, &DerivedHolder::derivedMethod2));
+
+    auto sig2 = metainfo::prepareEmit<SignalTestClass, int32_t>("sig2");
+    ASSERT_TRUE(sig2.isValid());
+    EXPECT_EQ(&SignalTestClass::StaticMetaClass::Sign2Des, sig2.signalType());
+    EXPECT_EQ(1, sig2(sender, 5));
+    EXPECT_EQ(5, receiver.derived2CallData());
+    EXPECT_EQ(1, sig2(sender, 6));
+    EXPECT_EQ(6, receiver.derived2CallData());
+
+    // Convertible arguments.
+    auto converted = metainfo::prepareEmit<SignalTestClass, std::string_view>("sig2");
+    ASSERT_TRUE(converted.isValid());
+    EXPECT_EQ(1, converted(sender, "7"));
+    EXPECT_EQ(7, receiver.derived2CallData());
+
+    // Not enough arguments, and non-existent signal.
+    auto sig3 = metainfo::prepareEmit<SignalTestClass, int32_t>("sig3");
+    EXPECT_FALSE(sig3.isValid());
+    EXPECT_EQ(-1, sig3(sender, 1));
+    EXPECT_FALSE((metainfo::prepareEmit<SignalTestClass>("sigV").isValid()));
+}
+
 TEST_F(SignalTest, test_metaclass_invoke_metasignals)
 {
     SignalTestClass sender;
@@ -619,3 +651,567 @@ TEST_F(SignalTest, test_metaclass_invoke_metasignals)
     // Invoke with not enough arguments.
     EXPECT_EQ(-1, mc->Sign2Des.emit(sender));
 }
+
+TEST_F(SignalTest, test_unconnected_signal)
+{
+    SignalTestClass sender;
+
+    // Unconnected signals are found, activate no slots, and have no connections to disconnect.
+    EXPECT_EQ(&sender.sig2, sender.findSignal(SignalTestClass::StaticMetaClass::Sign2Des));
+    EXPECT_EQ(0, sender.sig2(10));
+    EXPECT_EQ(-1, SignalTestClass::StaticMetaClass::Sign3Des.emit(sender, 10));
+    EXPECT_FALSE(sender.sig2.disconnect(sender.sig1));
+
+    int32_t value = 0;
+    auto slot = [&value](int32_t v)
+    {
+        value = v;
+    };
+    sender.sig2.setBlocked(true);
+    EXPECT_NOT_NULL(sender.sig2.connect(slot));
+    EXPECT_EQ(0, sender.sig2(10));
+    sender.sig2.setBlocked(false);
+    EXPECT_EQ(1, sender.sig2(10));
+    EXPECT_EQ(10, value);
+}
+
+TEST_F(SignalTest, test_has_connections)
+{
+    SignalTestClass sender;
+    EXPECT_FALSE(sender.sig2.hasConnections());
+
+    int32_t value = 0;
+    auto slot = [&value](int32_t v)
+    {
+        value = v;
+    };
+    auto connection = sender.sig2.connect(slot);
+    EXPECT_NOT_NULL(connection);
+    EXPECT_TRUE(sender.sig2.hasConnections());
+
+    sender.sig2.setBlocked(true);
+    EXPECT_FALSE(sender.sig2.hasConnections());
+    sender.sig2.setBlocked(false);
+    EXPECT_TRUE(sender.sig2.hasConnections());
+
+    // Convertible arguments are packed for the connection.
+    EXPECT_EQ(1, SignalTestClass::StaticMetaClass::Sign2Des.emit(sender, "10"sv));
+    EXPECT_EQ(10, value);
+
+    EXPECT_TRUE(connection->disconnect());
+    EXPECT_FALSE(sender.sig2.hasConnections());
+    EXPECT_EQ(0, SignalTestClass::StaticMetaClass::Sign2Des.emit(sender, "20"sv));
+    EXPECT_EQ(10, value);
+}
+
+TEST_F(SignalTest, test_emit_typed_and_packed_slots)
+{
+    SignalTestClass sender;
+
+    int32_t typedValue = 0;
+    std::string typedText;
+    auto typedSlot = [&typedValue, &typedText](int32_t value, std::string text)
+    {
+        typedValue = value;
+        typedText = text;
+    };
+    float convertedValue = 0.0f;
+    auto convertingSlot = [&convertedValue](float value)
+    {
+        convertedValue = value;
+    };
+    int32_t partialValue = 0;
+    auto partialSlot = [&partialValue](int32_t value)
+    {
+        partialValue = value;
+    };
+
+    EXPECT_NOT_NULL(sender.sig3.connect(typedSlot));
+    EXPECT_NOT_NULL(sender.sig3.connect(convertingSlot));
+    EXPECT_NOT_NULL(sender.sig3.connect(partialSlot));
+
+    EXPECT_EQ(3, sender.sig3(int32_t(42), std::string("apple")));
+    EXPECT_EQ(42, typedValue);
+    EXPECT_EQ("apple", typedText);
+    EXPECT_EQ(42.0f, convertedValue);
+    EXPECT_EQ(42, partialValue);
+}
+
+TEST_F(SignalTest, test_emit_typed_method_slots)
+{
+    SignalTestClass sender;
+    DerivedHolder receiver;
+
+    EXPECT_NOT_NULL(sender.sig2.connect(receiver, &DerivedHolder::derivedMethod2));
+    EXPECT_NOT_NULL(sender.sig2.connect(receiver, &SlotHolder::method4));
+    EXPECT_NOT_NULL(sender.sig2.connect(receiver.sig));
+    EXPECT_NOT_NULL(receiver.sig.connect(receiver, &SlotHolder::method2));
+
+    EXPECT_EQ(3, sender.sig2(int32_t(11)));
+    EXPECT_EQ(11, receiver.derived2CallData());
+    EXPECT_EQ(1, receiver.slot4CallCount());
+    EXPECT_EQ(1, receiver.slot2CallCount());
+
+    // Disconnected typed slots are not invoked.
+    EXPECT_TRUE(sender.sig2.disconnect(receiver, &DerivedHolder::derivedMethod2));
+    EXPECT_EQ(2, sender.sig2(int32_t(12)));
+    EXPECT_EQ(11, receiver.derived2CallData());
+}
+
+TEST_F(SignalTest, test_emit_typed_metasignal)
+{
+    SignalTestClass sender;
+    DerivedHolder receiver;
+    const SignalTestClass::StaticMetaClass* mc = SignalTestClass::StaticMetaClass::get();
+
+    EXPECT_NOT_NULL(sender.sig2.connect(receiver, &DerivedHolder::derivedMethod2));
+
+    // Exact argument types.
+    EXPECT_EQ(1, mc->Sign2Des.emit(sender, int32_t(5)));
+    EXPECT_EQ(5, receiver.derived2CallData());
+
+    // Convertible argument types.
+    EXPECT_EQ(1, mc->Sign2Des.emit(sender, "7"sv));
+    EXPECT_EQ(7, receiver.derived2CallData());
+}
+
+TEST_F(SignalTest, test_disconnect_typed_slot_in_emit)
+{
+    SignalTestClass sender;
+
+    int callCount = 0;
+    auto lambda = [&callCount](int32_t)
+    {
+        ++callCount;
+        Signal::Connection::getActiveConnection()->disconnect();
+    };
+
+    EXPECT_NOT_NULL(sender.sig2.connect(lambda));
+    EXPECT_EQ(1, sender.sig2(int32_t(1)));
+    EXPECT_EQ(0, sender.sig2(int32_t(1)));
+    EXPECT_EQ(1, callCount);
+}
+
+TEST_F(SignalTest, test_replace_connection_in_emit)
+{
+    SignalTestClass sender;
+
+    int replacedCount = 0;
+    auto replacement = [&replacedCount]()
+    {
+        ++replacedCount;
+    };
+    auto lambda = [&sender, &replacement]()
+    {
+        Signal::Connection::getActiveConnection()->disconnect();
+        sender.sig1.connect(replacement);
+    };
+
+    EXPECT_NOT_NULL(sender.sig1.connect(lambda));
+    EXPECT_EQ(1, sender.sig1());
+    EXPECT_EQ(0, replacedCount);
+    EXPECT_EQ(1, sender.sig1());
+    EXPECT_EQ(1, replacedCount);
+}
+
+TEST_F(SignalTest, test_deeply_nested_activations)
+{
+    // Each slot emits the signal of the next sender, nesting the activations deeper than the
+    // inline capacity of the active connection stack.
+    constexpr int depth = 600;
+    std::vector<std::unique_ptr<SignalTestClass>> senders;
+    for (int i = 0; i < depth; ++i)
+    {
+        senders.push_back(std::make_unique<SignalTestClass>());
+    }
+
+    int deepestCount = 0;
+    for (int i = 0; i < depth; ++i)
+    {
+        auto next = (i + 1 < depth) ? senders[i + 1].get() : nullptr;
+        auto slot = [next, &deepestCount]()
+        {
+            EXPECT_NOT_NULL(Signal::Connection::getActiveConnection());
+            if (next)
+            {
+                next->sig1();
+            }
+            else
+            {
+                ++deepestCount;
+            }
+        };
+        EXPECT_NOT_NULL(senders[i]->sig1.connect(slot));
+    }
+
+    EXPECT_EQ(1, senders.front()->sig1());
+    EXPECT_EQ(1, deepestCount);
+    EXPECT_NULL(Signal::Connection::getActiveConnection());
+}
+
+TEST_F(SignalTest, test_stateful_functor_in_typed_and_packed_emit)
+{
+    SignalTestClass sender;
+
+    struct Counter
+    {
+        int* lastCount;
+        mutable int count = 0;
+
+        void operator()(int32_t) const
+        {
+            *lastCount = ++count;
+        }
+    };
+
+    int lastCount = 0;
+    EXPECT_NOT_NULL(sender.sig2.connect(Counter{&lastCount}));
+
+    // The typed and the packed activation invoke the same functor.
+    EXPECT_EQ(1, sender.sig2(int32_t(1)));
+    EXPECT_EQ(1, lastCount);
+    EXPECT_EQ(1, sender.sig2.activate(Callable::ArgumentPack(int32_t(2))));
+    EXPECT_EQ(2, lastCount);
+    EXPECT_EQ(1, sender.sig2(int32_t(3)));
+    EXPECT_EQ(3, lastCount);
+
+    EXPECT_TRUE(sender.sig2.disconnect(Counter{&lastCount}));
+    EXPECT_EQ(0, sender.sig2(int32_t(4)));
+}
+
+namespace
+{
+
+// Emits the sig2 of a sender emitCount times from threadCount threads, and returns the number of
+// connections the emissions activated.
+int emitFromThreads(SignalTestClass& sender, unsigned threadCount, int emitCount)
+{
+    std::atomic_int activationCount = 0;
+    auto emitter = [&sender, &activationCount, emitCount]()
+    {
+        for (int i = 0; i < emitCount; ++i)
+        {
+            activationCount += sender.sig2(int32_t(i));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0u; i < threadCount; ++i)
+    {
+        threads.emplace_back(emitter);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    return activationCount;
+}
+
+}
+
+TEST_F(SignalTest, test_emit_from_multiple_threads)
+{
+    SignalTestClass sender;
+
+    std::atomic_int slotCount = 0;
+    auto lambda = [&slotCount](int32_t)
+    {
+        ++slotCount;
+    };
+    EXPECT_NOT_NULL(sender.sig2.connect(lambda));
+
+    // No emission is lost.
+    constexpr unsigned threadCount = 4u;
+    constexpr int emitCount = 20000;
+    EXPECT_EQ(int(threadCount) * emitCount, emitFromThreads(sender, threadCount, emitCount));
+    EXPECT_EQ(int(threadCount) * emitCount, slotCount);
+}
+
+TEST_F(SignalTest, test_emit_to_many_slots)
+{
+    SignalTestClass sender;
+
+    int slotCount = 0;
+    auto lambda = [&slotCount](int32_t)
+    {
+        ++slotCount;
+    };
+    constexpr int connectionCount = 16;
+    for (int i = 0; i < connectionCount; ++i)
+    {
+        EXPECT_NOT_NULL(sender.sig2.connect(lambda));
+    }
+
+    constexpr int emitCount = 100;
+    for (int i = 0; i < emitCount; ++i)
+    {
+        EXPECT_EQ(connectionCount, sender.sig2(int32_t(i)));
+    }
+    EXPECT_EQ(connectionCount * emitCount, slotCount);
+}
+
+TEST_F(SignalTest, test_connect_many_slots)
+{
+    SignalTestClass sender;
+
+    int slotCount = 0;
+    auto lambda = [&slotCount](int32_t)
+    {
+        ++slotCount;
+    };
+    constexpr int connectionCount = 1000;
+    for (int i = 0; i < connectionCount; ++i)
+    {
+        EXPECT_NOT_NULL(sender.sig2.connect(lambda));
+    }
+
+    EXPECT_EQ(connectionCount, sender.sig2(int32_t(1)));
+    EXPECT_EQ(connectionCount, slotCount);
+}
+
+TEST_F(SignalTest, test_receiver_destruction_disconnects)
+{
+    SignalTestClass sender;
+    {
+        SlotHolder receiver;
+        EXPECT_NOT_NULL(sender.sig2.connect(receiver, &SlotHolder::method2));
+        EXPECT_NOT_NULL(sender.sig2.connect(receiver.sig));
+        EXPECT_NOT_NULL(metainfo::connect(sender, "sig1", receiver, "method1"));
+        EXPECT_TRUE(sender.sig1.hasConnections());
+        EXPECT_TRUE(sender.sig2.hasConnections());
+    }
+    EXPECT_FALSE(sender.sig1.hasConnections());
+    EXPECT_FALSE(sender.sig2.hasConnections());
+    EXPECT_EQ(0, sender.sig2(1));
+}
+
+TEST_F(SignalTest, test_receiver_signal_destruction_disconnects)
+{
+    SignalTestClass sender;
+    SlotHolder receiver;
+    auto signal = std::make_unique<Signal>(receiver, SlotHolder::StaticMetaClass::SigDes);
+    EXPECT_NOT_NULL(sender.sig2.connect(*signal));
+    EXPECT_NOT_NULL(sender.sig2.connect(receiver.sig));
+    EXPECT_EQ(2, sender.sig2(1));
+
+    // The receiver outlives its signal.
+    signal.reset();
+    EXPECT_EQ(1, sender.sig2(1));
+}
+
+TEST_F(SignalTest, test_disconnect_many_receivers)
+{
+    SignalTestClass sender;
+    constexpr int receiverCount = 200;
+    std::vector<std::unique_ptr<SlotHolder>> receivers;
+    for (int i = 0; i < receiverCount; ++i)
+    {
+        receivers.push_back(std::make_unique<SlotHolder>());
+        EXPECT_NOT_NULL(sender.sig2.connect(*receivers.back(), &SlotHolder::method2));
+        EXPECT_NOT_NULL(sender.sig2.connect(receivers.back()->sig));
+    }
+
+    for (int i = 0; i < receiverCount; i += 2)
+    {
+        EXPECT_TRUE(sender.sig2.disconnect(*receivers[i], &SlotHolder::method2));
+        EXPECT_TRUE(sender.sig2.disconnect(receivers[i]->sig));
+    }
+    EXPECT_EQ(receiverCount, sender.sig2(int32_t(1)));
+
+    // Destroy the rest of the receivers with their connections.
+    receivers.clear();
+    EXPECT_FALSE(sender.sig2.hasConnections());
+}
+
+TEST_F(SignalTest, test_sender_and_receivers_destroyed_on_different_threads)
+{
+    constexpr int rounds = 100;
+    constexpr int receiverCount = 16;
+    for (int round = 0; round < rounds; ++round)
+    {
+        auto sender = std::make_unique<SignalTestClass>();
+        std::vector<std::unique_ptr<SlotHolder>> receivers;
+        for (int i = 0; i < receiverCount; ++i)
+        {
+            receivers.push_back(std::make_unique<SlotHolder>());
+            EXPECT_NOT_NULL(sender->sig2.connect(*receivers.back(), &SlotHolder::method2));
+            EXPECT_NOT_NULL(sender->sig2.connect(receivers.back()->sig));
+        }
+
+        // The receivers disconnect from the sender while the sender gets destroyed.
+        std::thread receiverThread([&receivers]() { receivers.clear(); });
+        sender.reset();
+        receiverThread.join();
+        EXPECT_TRUE(receivers.empty());
+    }
+}
+
+TEST_F(SignalTest, test_emit_shared_buffer)
+{
+    static SignalTypeDecl<Int32Buffer> BufferSignalType;
+    TestEmitterNoMetaClass emitter;
+    Signal bufferSignal{emitter, BufferSignalType};
+
+    Int32Buffer buffer(std::vector<int32_t>(16384u, 1));
+    std::vector<const int32_t*> received;
+    auto slot = [&received](Int32Buffer samples)
+    {
+        received.push_back(samples.data());
+    };
+    EXPECT_NOT_NULL(bufferSignal.connect(slot));
+
+    // Neither the typed, nor the packed activation copies the buffer.
+    EXPECT_EQ(1, bufferSignal(buffer));
+    EXPECT_EQ(1, bufferSignal.activate(Callable::ArgumentPack(buffer)));
+    ASSERT_EQ(2u, received.size());
+    EXPECT_EQ(buffer.data(), received[0]);
+    EXPECT_EQ(buffer.data(), received[1]);
+}
+
+TEST_F(SignalTest, test_emit_parallel)
+{
+    SignalTestClass sender;
+    SlotHolder receiver;
+
+    constexpr int connectionCount = 64;
+    std::atomic_int slotCount = 0;
+    auto lambda = [&slotCount](int32_t value)
+    {
+        slotCount += value;
+    };
+    for (int i = 0; i < connectionCount; ++i)
+    {
+        EXPECT_NOT_NULL(sender.sig2.connect(lambda));
+    }
+    // The connected signal is activated on the activating thread.
+    const auto activatingThread = std::this_thread::get_id();
+    std::thread::id signalThread;
+    auto signalSlot = [&signalThread]()
+    {
+        signalThread = std::this_thread::get_id();
+    };
+    EXPECT_NOT_NULL(receiver.sig.connect(signalSlot));
+    EXPECT_NOT_NULL(sender.sig2.connect(receiver.sig));
+
+    EXPECT_EQ(connectionCount + 1, sender.sig2.activateParallel(Callable::ArgumentPack(int32_t(1))).get());
+    EXPECT_EQ(connectionCount, slotCount);
+    EXPECT_EQ(activatingThread, signalThread);
+    EXPECT_EQ(-1, sender.sig2.activateParallel(Callable::ArgumentPack()).get());
+}
+
+TEST_F(SignalTest, test_emit_parallel_exception)
+{
+    SignalTestClass sender;
+    auto lambda = []()
+    {
+        throw std::runtime_error("slot failure");
+    };
+    EXPECT_NOT_NULL(sender.sig1.connect(lambda));
+    auto activation = sender.sig1.activateParallel(Callable::ArgumentPack());
+    EXPECT_THROW(activation.get(), std::runtime_error);
+}
+
+TEST_F(SignalTest, DISABLED_benchmark_emit_from_multiple_threads)
+{
+    SignalTestClass sender;
+    std::atomic_int slotCount = 0;
+    auto lambda = [&slotCount](int32_t)
+    {
+        ++slotCount;
+    };
+    sender.sig2.connect(lambda);
+
+    constexpr int emitCount = 20000;
+    const unsigned maxThreads = std::max(4u, std::thread::hardware_concurrency());
+    for (unsigned threadCount = 1u; threadCount <= maxThreads; threadCount *= 2)
+    {
+        auto elapsed = Benchmark::measure([&sender, threadCount]() { emitFromThreads(sender, threadCount, emitCount); });
+        Benchmark::recordRate("emit_per_ms_" + std::to_string(threadCount) + "_threads", int64_t(threadCount) * emitCount, elapsed);
+    }
+}
+
+TEST_F(SignalTest, DISABLED_benchmark_emit_to_many_slots)
+{
+    SignalTestClass sender;
+    int slotCount = 0;
+    auto lambda = [&slotCount](int32_t)
+    {
+        ++slotCount;
+    };
+    for (int i = 0; i < 16; ++i)
+    {
+        sender.sig2.connect(lambda);
+    }
+
+    constexpr int emitCount = 20000;
+    auto emitAll = [&sender]()
+    {
+        for (int i = 0; i < emitCount; ++i)
+        {
+            sender.sig2(int32_t(i));
+        }
+    };
+    auto elapsed = Benchmark::measure(emitAll);
+    Benchmark::recordRate("slot_calls_per_ms", slotCount, elapsed);
+}
+
+TEST_F(SignalTest, DISABLED_benchmark_connect_many_slots)
+{
+    SignalTestClass sender;
+    auto lambda = [](int32_t) {};
+
+    constexpr int connectionCount = 10000;
+    auto connect = [&sender, &lambda]()
+    {
+        for (int i = 0; i < connectionCount; ++i)
+        {
+            sender.sig2.connect(lambda);
+        }
+    };
+    auto elapsed = Benchmark::measure(connect);
+    Benchmark::recordRate("connects_per_ms", connectionCount, elapsed);
+}
+
+TEST_F(SignalTest, DISABLED_benchmark_disconnect_many_receivers)
+{
+    SignalTestClass sender;
+    constexpr int receiverCount = 2000;
+    std::vector<std::unique_ptr<SlotHolder>> receivers;
+    for (int i = 0; i < receiverCount; ++i)
+    {
+        receivers.push_back(std::make_unique<SlotHolder>());
+        sender.sig2.connect(*receivers.back(), &SlotHolder::method2);
+        sender.sig2.connect(receivers.back()->sig);
+    }
+
+    auto teardown = [&sender, &receivers]()
+    {
+        for (int i = 0; i < receiverCount; i += 2)
+        {
+            sender.sig2.disconnect(*receivers[i], &SlotHolder::method2);
+            sender.sig2.disconnect(receivers[i]->sig);
+        }
+        receivers.clear();
+    };
+    Benchmark::recordDuration("receiver_teardown_us", Benchmark::measure(teardown));
+}
+
+TEST_F(SignalTest, DISABLED_benchmark_emit_parallel)
+{
+    SignalTestClass sender;
+    std::atomic_int slotCount = 0;
+    auto lambda = [&slotCount](int32_t value)
+    {
+        slotCount += value;
+    };
+    for (int i = 0; i < 64; ++i)
+    {
+        sender.sig2.connect(lambda);
+    }
+
+    auto emitAll = [&sender]()
+    {
+        sender.sig2.activateParallel(Callable::ArgumentPack(int32_t(1))).get();
+    };
+    Benchmark::recordDuration("parallel_emit_us", Benchmark::measure(emitAll));
+}
@@ -20,6 +20,10 @@
 #include <mox/core/object.hpp>
 #include "test_framework.h"
 
+#include <chrono>
+#include <future>
+#include <stdexcept>
+
 static const mox::EventType evQuit = mox::Event::registerNewType();
 
 class Quitter : public mox::Object
@@ -43,6 +47,60 @@ public:
     };
 };
 
+class ValueEmitter : public mox::MetaBase
+{
+public:
+    static inline mox::SignalTypeDecl<int> ValueSignalType;
+    mox::Signal value{*this, ValueSignalType};
+};
+
+class ValueCollector : public mox::Object
+{
+public:
+    std::vector<int> values;
+    std::size_t expectedCount = 0u;
+    mox::ThreadPromise completed;
+
+    static std::shared_ptr<ValueCollector> create(mox::Object* parent = nullptr)
+    {
+        return createObject(new ValueCollector, parent);
+    }
+
+    void collect(int value)
+    {
+        values.push_back(value);
+        if (values.size() == expectedCount)
+        {
+            completed.set_value();
+        }
+    }
+
+    int sum(int a, int b)
+    {
+        return a + b;
+    }
+
+    void reject(int)
+    {
+        throw std::runtime_error("rejected");
+    }
+
+    void collectPositive(int value)
+    {
+        if (value < 0)
+        {
+            throw std::runtime_error("negative value");
+        }
+        collect(value);
+    }
+
+    MetaInfo(ValueCollector, mox::Object)
+    {
+        static inline MetaMethod<ValueCollector> collect{&ValueCollector::collect, "collect"};
+        static inline MetaMethod<ValueCollector> reject{&ValueCollector::reject, "reject"};
+    };
+};
+
 class Threads : public UnitTest
 {
 protected:
@@ -51,6 +109,7 @@ protected:
         UnitTest::SetUp();
 
         mox::registerMetaClass<Quitter>();
+        mox::registerMetaClass<ValueCollector>();
     }
 };
 
@@ -328,3 +387,191 @@ TEST_F(Threads, test_signal_connected_to_metamethod_in_different_thread)
     watchDeath.wait();
     EXPECT_EQ(0, TestThreadLoop::threadCount);
 }
+
+TEST_F(Threads, test_deferred_signals_delivered_in_order)
+{
+    TestApp app;
+    constexpr int emitCount = 10000;
+
+    auto thread = mox::ThreadLoop::create();
+    auto collector = ValueCollector::create(thread.get());
+    collector->expectedCount = emitCount;
+    auto completed = collector->completed.get_future();
+
+    ValueEmitter emitter;
+    EXPECT_NOT_NULL(emitter.value.connect(*collector, &ValueCollector::collect));
+
+    thread->start();
+    EXPECT_NE(collector->threadData(), mox::ThreadData::getThisThreadData());
+
+    for (int i = 0; i < emitCount; ++i)
+    {
+        emitter.value(i);
+    }
+    EXPECT_EQ(std::future_status::ready, completed.wait_for(std::chrono::seconds(10)));
+
+    thread->exit();
+    thread->join();
+
+    ASSERT_EQ(std::size_t(emitCount), collector->values.size());
+    for (int i = 0; i < emitCount; ++i)
+    {
+        EXPECT_EQ(i, collector->values[std::size_t(i)]);
+    }
+    app.runOnce();
+}
+
+TEST_F(Threads, test_deferred_signal_batch_survives_failing_slot)
+{
+    TestApp app;
+
+    auto thread = mox::ThreadLoop::create();
+    auto collector = ValueCollector::create(thread.get());
+    collector->expectedCount = 4u;
+    auto completed = collector->completed.get_future();
+
+    ValueEmitter emitter;
+    EXPECT_NOT_NULL(emitter.value.connect(*collector, &ValueCollector::collectPositive));
+
+    thread->start();
+
+    // Keep the thread busy, so that the activations land in the same batch.
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto hold = [released]()
+    {
+        released.wait();
+    };
+    auto held = mox::invokeOn(collector, hold);
+    emitter.value(1);
+    emitter.value(2);
+    emitter.value(-1);
+    emitter.value(3);
+    emitter.value(4);
+    release.set_value();
+    held.wait();
+
+    // The activations after the failing one are delivered without a further emit.
+    EXPECT_EQ(std::future_status::ready, completed.wait_for(std::chrono::seconds(10)));
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 4}), collector->values);
+
+    thread->exit();
+    thread->join();
+    app.runOnce();
+}
+
+TEST_F(Threads, test_invoke_on_thread)
+{
+    TestApp app;
+
+    auto thread = mox::ThreadLoop::create();
+    auto collector = ValueCollector::create(thread.get());
+    thread->start();
+
+    auto threadData = collector->threadData();
+    EXPECT_NE(threadData, mox::ThreadData::getThisThreadData());
+    auto isInThread = [threadData]()
+    {
+        return mox::ThreadData::getThisThreadData() == threadData;
+    };
+    auto inThread = mox::invokeOn(collector, isInThread);
+    EXPECT_EQ(std::future_status::ready, inThread.wait_for(std::chrono::seconds(10)));
+    EXPECT_TRUE(bool(inThread.get()));
+
+    auto sum = mox::invokeOn(collector, &ValueCollector::sum, 1, 2);
+    EXPECT_EQ(3, int(sum.get()));
+
+    thread->exit();
+    thread->join();
+    app.runOnce();
+}
+
+TEST_F(Threads, test_blocking_queued_connection)
+{
+    TestApp app;
+
+    auto thread = mox::ThreadLoop::create();
+    auto collector = ValueCollector::create(thread.get());
+    ValueEmitter emitter;
+    EXPECT_NOT_NULL(emitter.value.connect(*collector, &ValueCollector::collect, mox::Signal::ConnectionType::BlockingQueued));
+    thread->start();
+
+    // Each activation returns after the receiver's thread completed the slot.
+    for (int i = 0; i < 3; ++i)
+    {
+        emitter.value(i);
+        EXPECT_EQ(std::size_t(i + 1), collector->values.size());
+    }
+
+    thread->exit();
+    thread->join();
+    app.runOnce();
+}
+
+TEST_F(Threads, test_blocking_queued_metamethod_connection)
+{
+    TestApp app;
+
+    auto thread = mox::ThreadLoop::create();
+    auto collector = ValueCollector::create(thread.get());
+    ValueEmitter emitter;
+    EXPECT_NOT_NULL(mox::metainfo::connect(emitter.value, *collector, ValueCollector::StaticMetaClass::collect, mox::Signal::ConnectionType::BlockingQueued));
+    thread->start();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        emitter.value(i);
+        EXPECT_EQ(std::size_t(i + 1), collector->values.size());
+    }
+
+    thread->exit();
+    thread->join();
+    app.runOnce();
+}
+
+TEST_F(Threads, test_blocking_queued_connection_rethrows)
+{
+    TestApp app;
+
+    auto thread = mox::ThreadLoop::create();
+    auto collector = ValueCollector::create(thread.get());
+    ValueEmitter emitter;
+    EXPECT_NOT_NULL(emitter.value.connect(*collector, &ValueCollector::reject, mox::Signal::ConnectionType::BlockingQueued));
+    thread->start();
+
+    // The exception of the slot is rethrown to the emitting thread.
+    EXPECT_THROW(emitter.value(1), std::runtime_error);
+
+    thread->exit();
+    thread->join();
+    app.runOnce();
+}
+
+TEST_F(Threads, DISABLED_benchmark_deferred_signals)
+{
+    TestApp app;
+    constexpr int emitCount = 10000;
+
+    auto thread = mox::ThreadLoop::create();
+    auto collector = ValueCollector::create(thread.get());
+    collector->expectedCount = emitCount;
+    auto completed = collector->completed.get_future();
+
+    ValueEmitter emitter;
+    emitter.value.connect(*collector, &ValueCollector::collect);
+    thread->start();
+
+    auto emitAll = [&emitter, &completed]()
+    {
+        for (int i = 0; i < emitCount; ++i)
+        {
+            emitter.value(i);
+        }
+        completed.wait_for(std::chrono::seconds(10));
+    };
+    Benchmark::recordRate("deferred_emits_per_ms", emitCount, Benchmark::measure(emitAll));
+
+    thread->exit();
+    thread->join();
+    app.runOnce();
+}